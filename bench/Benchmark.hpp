@@ -0,0 +1,46 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+namespace Shared::Bench {
+    /**
+     * Time func, which processes items values per call, and print the average cost per value.
+     * func is repeated until at least MinDuration has passed so short runs are not dominated by timer resolution.
+     */
+    template <class FUNC>
+    void Measure(const char* name, size_t items, FUNC&& func)
+    {
+        constexpr std::chrono::milliseconds MinDuration(200);
+
+        // Warm up caches and let the clock settle before timing.
+        func();
+
+        size_t                                iterations = 0;
+        std::chrono::steady_clock::duration   elapsed{};
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        do
+        {
+            func();
+            ++iterations;
+            elapsed = std::chrono::steady_clock::now() - start;
+        } while (elapsed < MinDuration);
+
+        double nanoseconds = std::chrono::duration<double, std::nano>(elapsed).count();
+        std::printf("%-48s %10.3f ns/item\n", name, nanoseconds / static_cast<double>(iterations * items));
+    }
+
+    /**
+     * Keep the compiler from discarding a result that is otherwise unused.
+     */
+    template <class T>
+    void DoNotOptimize(const T& value)
+    {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    void RunFixedPointArray();
+    void RunFixedPointMath();
+    void RunFixedPointDsp();
+} // namespace Shared::Bench
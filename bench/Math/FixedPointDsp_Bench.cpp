@@ -0,0 +1,85 @@
+#include "../Benchmark.hpp"
+
+#include <Math/FixedPointDsp.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace Shared::Bench {
+    namespace {
+        typedef FixedPoint<int16_t, 1, 15>  Q1_15;
+        typedef FixedPoint<int32_t, 16, 16> Q16_16;
+
+        constexpr size_t Count = 4096;
+        constexpr size_t Taps  = 32;
+
+        std::vector<Q1_15> makeValues(uint32_t seed)
+        {
+            std::mt19937                           generator(seed);
+            std::uniform_int_distribution<int32_t> distribution(Q1_15::MinRawValue, Q1_15::MaxRawValue);
+
+            std::vector<Q1_15> values(Count);
+            for (Q1_15& value : values)
+            {
+                value = Q1_15::FromRaw(static_cast<int16_t>(distribution(generator)));
+            }
+            return values;
+        }
+
+        std::vector<double> toDouble(const std::vector<Q1_15>& values)
+        {
+            std::vector<double> result(values.size());
+            for (size_t i = 0; i < values.size(); ++i)
+            {
+                result[i] = values[i].ToDouble();
+            }
+            return result;
+        }
+    } // namespace
+
+    void RunFixedPointDsp()
+    {
+        std::vector<Q1_15>  lhs       = makeValues(1);
+        std::vector<Q1_15>  rhs       = makeValues(2);
+        std::vector<double> doubleLhs = toDouble(lhs);
+        std::vector<double> doubleRhs = toDouble(rhs);
+
+        Measure("FixedPointDsp::DotProduct<Q1_15>", Count, [&] {
+            DoNotOptimize(FixedPointDsp::DotProduct<Q16_16>(lhs.data(), rhs.data(), Count));
+        });
+        Measure("double dot product", Count, [&] {
+            double sum = 0;
+            for (size_t i = 0; i < Count; ++i)
+            {
+                sum += doubleLhs[i] * doubleRhs[i];
+            }
+            DoNotOptimize(sum);
+        });
+
+        FirFilter<Q1_15, Q1_15> filter(rhs.data(), Taps);
+        std::vector<Q1_15>      output(Count);
+        Measure("FirFilter<Q1_15> 32 taps", Count, [&] {
+            filter.Process(lhs.data(), output.data(), Count);
+            DoNotOptimize(output.data());
+        });
+
+        std::vector<double> doubleOutput(Count);
+        std::vector<double> history(Taps - 1 + Count);
+        Measure("double FIR 32 taps", Count, [&] {
+            std::copy(doubleLhs.begin(), doubleLhs.end(), history.begin() + Taps - 1);
+            for (size_t i = 0; i < Count; ++i)
+            {
+                double sum = 0;
+                for (size_t k = 0; k < Taps; ++k)
+                {
+                    sum += doubleRhs[k] * history[i + Taps - 1 - k];
+                }
+                doubleOutput[i] = sum;
+            }
+            std::copy(history.end() - (Taps - 1), history.end(), history.begin());
+            DoNotOptimize(doubleOutput.data());
+        });
+    }
+} // namespace Shared::Bench
@@ -0,0 +1,80 @@
+#include "../Benchmark.hpp"
+
+#include <Math/FixedPointMath.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace Shared::Bench {
+    namespace {
+        typedef FixedPoint<int32_t, 16, 16> Q16_16;
+
+        constexpr size_t Count = 1024;
+
+        std::vector<double> makeValues(double low, double high)
+        {
+            std::mt19937                           generator(42);
+            std::uniform_real_distribution<double> distribution(low, high);
+
+            std::vector<double> values(Count);
+            for (double& value : values)
+            {
+                value = distribution(generator);
+            }
+            return values;
+        }
+
+        std::vector<Q16_16> toFixed(const std::vector<double>& values)
+        {
+            return std::vector<Q16_16>(values.begin(), values.end());
+        }
+
+        template <class VALUE_TYPE, class FUNC>
+        void measureUnary(const char* name, const std::vector<VALUE_TYPE>& values, FUNC&& func)
+        {
+            Measure(name, values.size(), [&] {
+                for (const VALUE_TYPE& value : values)
+                {
+                    DoNotOptimize(func(value));
+                }
+            });
+        }
+    } // namespace
+
+    void RunFixedPointMath()
+    {
+        std::vector<double> angles      = makeValues(-8.0, 8.0);
+        std::vector<Q16_16> fixedAngles = toFixed(angles);
+        measureUnary("FixedPointMath::Sin<Q16_16>", fixedAngles, [](Q16_16 x) { return FixedPointMath::Sin(x); });
+        measureUnary("FixedPointMath::SinLookup<Q16_16>", fixedAngles,
+                     [](Q16_16 x) { return FixedPointMath::SinLookup(x); });
+        measureUnary("std::sin(double)", angles, [](double x) { return std::sin(x); });
+
+        std::vector<double> exponents      = makeValues(-8.0, 8.0);
+        std::vector<Q16_16> fixedExponents = toFixed(exponents);
+        measureUnary("FixedPointMath::Exp<Q16_16>", fixedExponents, [](Q16_16 x) { return FixedPointMath::Exp(x); });
+        measureUnary("std::exp(double)", exponents, [](double x) { return std::exp(x); });
+
+        std::vector<double> radicands      = makeValues(0.0, 30000.0);
+        std::vector<Q16_16> fixedRadicands = toFixed(radicands);
+        measureUnary("FixedPointMath::Sqrt<Q16_16>", fixedRadicands, [](Q16_16 x) { return FixedPointMath::Sqrt(x); });
+        measureUnary("std::sqrt(double)", radicands, [](double x) { return std::sqrt(x); });
+
+        std::vector<double> ordinates      = makeValues(-100.0, 100.0);
+        std::vector<Q16_16> fixedOrdinates = toFixed(ordinates);
+        Measure("FixedPointMath::Atan2<Q16_16>", Count, [&] {
+            for (size_t i = 0; i < Count; ++i)
+            {
+                DoNotOptimize(FixedPointMath::Atan2(fixedOrdinates[i], fixedAngles[i]));
+            }
+        });
+        Measure("std::atan2(double)", Count, [&] {
+            for (size_t i = 0; i < Count; ++i)
+            {
+                DoNotOptimize(std::atan2(ordinates[i], angles[i]));
+            }
+        });
+    }
+} // namespace Shared::Bench
@@ -0,0 +1,64 @@
+#include "../Benchmark.hpp"
+
+#include <Serialize/FixedPointArray.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace Shared::Bench {
+    namespace {
+        typedef FixedPoint<int16_t, 4, 12>  Q4_12;
+        typedef FixedPoint<int32_t, 16, 16> Q16_16;
+
+        template <class FIXED_TYPE>
+        void runType(const char* quantizeName, const char* scalarName, const char* dequantizeName)
+        {
+            typedef FixedPointArray<FIXED_TYPE>                       arrayType;
+            typedef decltype(std::declval<FIXED_TYPE>().ToIntegral()) baseType;
+            constexpr size_t                                          count = 4096;
+
+            std::mt19937                          generator(42);
+            std::uniform_real_distribution<float> distribution(static_cast<float>(FIXED_TYPE::GetMin()),
+                                                               static_cast<float>(FIXED_TYPE::GetMax()));
+            std::vector<float> values(count);
+            for (float& value : values)
+            {
+                value = distribution(generator);
+            }
+            std::vector<baseType> raw(count);
+            std::vector<float>    restored(count);
+
+            Measure(quantizeName, count, [&] {
+                DoNotOptimize(arrayType::Quantize(values.data(), count, raw.data()));
+            });
+
+            // Baseline: the per value rounding and clamping a caller would write without FixedPointArray.
+            const float scale = static_cast<float>(1.0 / FIXED_TYPE::GetStepSize());
+            const float low   = static_cast<float>(FIXED_TYPE::MinRawValue);
+            const float high  = static_cast<float>(FIXED_TYPE::MaxRawValue);
+            Measure(scalarName, count, [&] {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    raw[i] = static_cast<baseType>(std::fmin(std::fmax(std::nearbyint(values[i] * scale), low), high));
+                }
+                DoNotOptimize(raw.data());
+            });
+
+            Measure(dequantizeName, count, [&] {
+                arrayType::Dequantize(raw.data(), count, restored.data());
+                DoNotOptimize(restored.data());
+            });
+        }
+    } // namespace
+
+    void RunFixedPointArray()
+    {
+        runType<Q4_12>("FixedPointArray<Q4_12>::Quantize(float)", "Q4_12 scalar quantize loop",
+                       "FixedPointArray<Q4_12>::Dequantize(float)");
+        runType<Q16_16>("FixedPointArray<Q16_16>::Quantize(float)", "Q16_16 scalar quantize loop",
+                        "FixedPointArray<Q16_16>::Dequantize(float)");
+    }
+} // namespace Shared::Bench
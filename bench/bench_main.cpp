@@ -0,0 +1,9 @@
+#include "Benchmark.hpp"
+
+int main()
+{
+    Shared::Bench::RunFixedPointArray();
+    Shared::Bench::RunFixedPointMath();
+    Shared::Bench::RunFixedPointDsp();
+    return 0;
+}
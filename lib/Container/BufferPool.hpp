@@ -0,0 +1,150 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <memory_resource>
+
+namespace Shared {
+    /**
+     * Memory resource caching freed blocks in power of two size classes.
+     * Blocks from MinBlockSize to MaxBlockSize bytes are rounded up to their size class and returned to a
+     * per class free list when deallocated, so a steady stream of similarly sized buffers (e.g. one
+     * BinaryWriter per message) stops hitting the upstream allocator once the lists are warm. Larger
+     * requests go straight to the upstream resource.
+     * The pool is not thread safe. Use ThreadLocal() for a per thread instance and release blocks on the
+     * thread that allocated them.
+     */
+    class BufferPool : public std::pmr::memory_resource {
+      public:
+        static constexpr size_t MinBlockSize   = 64;
+        static constexpr size_t NumSizeClasses = 15;
+        static constexpr size_t MaxBlockSize   = MinBlockSize << (NumSizeClasses - 1);
+
+        /**
+         * @param maxCachedBlocks: Maximum number of free blocks kept per size class.
+         * @param pUpstream: Resource the blocks are allocated from.
+         */
+        explicit BufferPool(
+            size_t                     maxCachedBlocks = 16,
+            std::pmr::memory_resource* pUpstream       = std::pmr::get_default_resource())
+            : m_pUpstream(pUpstream)
+            , m_MaxCachedBlocks(maxCachedBlocks)
+            , m_FreeLists{}
+            , m_FreeCounts{}
+        {
+        }
+
+        BufferPool(const BufferPool&)            = delete;
+        BufferPool& operator=(const BufferPool&) = delete;
+
+        ~BufferPool() override { Release(); }
+
+        /**
+         * @return Pool for the calling thread, created on first use.
+         */
+        static BufferPool& ThreadLocal()
+        {
+            thread_local BufferPool pool;
+            return pool;
+        }
+
+        /**
+         * Return all cached free blocks to the upstream resource. Blocks in use are unaffected.
+         */
+        void Release()
+        {
+            for (size_t sizeClass = 0; sizeClass < NumSizeClasses; ++sizeClass)
+            {
+                while (m_FreeLists[sizeClass] != nullptr)
+                {
+                    FreeBlock* pBlock      = m_FreeLists[sizeClass];
+                    m_FreeLists[sizeClass] = pBlock->pNext;
+                    m_pUpstream->deallocate(pBlock, blockSize(sizeClass), alignof(std::max_align_t));
+                }
+                m_FreeCounts[sizeClass] = 0;
+            }
+        }
+
+        /**
+         * @return Number of free blocks currently cached across all size classes.
+         */
+        size_t GetCachedBlockCount() const
+        {
+            size_t count{0};
+            for (size_t classCount : m_FreeCounts)
+            {
+                count += classCount;
+            }
+            return count;
+        }
+
+        std::pmr::memory_resource* GetUpstream() const { return m_pUpstream; }
+
+      protected:
+        void* do_allocate(size_t bytes, size_t alignment) override
+        {
+            if (!isPooled(bytes, alignment))
+                return m_pUpstream->allocate(bytes, alignment);
+
+            size_t sizeClass = getSizeClass(bytes);
+            if (FreeBlock* pBlock = m_FreeLists[sizeClass])
+            {
+                m_FreeLists[sizeClass] = pBlock->pNext;
+                --m_FreeCounts[sizeClass];
+                return pBlock;
+            }
+
+            return m_pUpstream->allocate(blockSize(sizeClass), alignof(std::max_align_t));
+        }
+
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override
+        {
+            if (!isPooled(bytes, alignment))
+            {
+                m_pUpstream->deallocate(p, bytes, alignment);
+                return;
+            }
+
+            size_t sizeClass = getSizeClass(bytes);
+            if (m_FreeCounts[sizeClass] >= m_MaxCachedBlocks)
+            {
+                m_pUpstream->deallocate(p, blockSize(sizeClass), alignof(std::max_align_t));
+                return;
+            }
+
+            FreeBlock* pBlock      = static_cast<FreeBlock*>(p);
+            pBlock->pNext          = m_FreeLists[sizeClass];
+            m_FreeLists[sizeClass] = pBlock;
+            ++m_FreeCounts[sizeClass];
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+      private:
+        /**
+         * Free blocks are linked through their own storage.
+         */
+        struct FreeBlock
+        {
+            FreeBlock* pNext;
+        };
+
+        static bool isPooled(size_t bytes, size_t alignment)
+        {
+            return bytes <= MaxBlockSize && alignment <= alignof(std::max_align_t);
+        }
+
+        static size_t getSizeClass(size_t bytes)
+        {
+            return bytes <= MinBlockSize ? 0 : std::bit_width((bytes - 1) / MinBlockSize);
+        }
+
+        static size_t blockSize(size_t sizeClass) { return MinBlockSize << sizeClass; }
+
+        std::pmr::memory_resource*             m_pUpstream;
+        size_t                                 m_MaxCachedBlocks;
+        std::array<FreeBlock*, NumSizeClasses> m_FreeLists;
+        std::array<size_t, NumSizeClasses>     m_FreeCounts;
+    };
+} // namespace Shared
@@ -0,0 +1,410 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <utility>
+
+namespace Shared {
+    /**
+     * Dynamically sized counterpart to StaticQueue.
+     * Elements are stored in a ring buffer whose capacity is always a power of two, so wrapping is a mask
+     * instead of a compare. When the ring is full the storage doubles and the elements are unwrapped into
+     * the new buffer with a single relocation.
+     * @tparam T: Type of the queued values.
+     * @tparam Allocator: Allocator used for the ring storage (std::pmr::polymorphic_allocator is supported).
+     */
+    template <class T, class Allocator = std::allocator<T>>
+    class DynamicQueue {
+        using alloc_traits = std::allocator_traits<Allocator>;
+        using pointer      = typename alloc_traits::pointer;
+
+        static constexpr size_t MinCapacity = 8;
+
+        [[no_unique_address]] Allocator m_Allocator;
+        pointer                         m_pStorage;
+        size_t                          m_Capacity;
+        size_t                          m_Head;
+        size_t                          m_Size;
+
+      public:
+        class Iterator {
+            pointer m_pStorage;
+            size_t  m_Mask;
+            size_t  m_CurLoc;
+
+          public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using difference_type   = std::ptrdiff_t;
+
+            Iterator(pointer storage, size_t mask, size_t loc)
+                : m_pStorage(storage)
+                , m_Mask(mask)
+                , m_CurLoc(loc)
+            {
+            }
+
+            Iterator& operator++()
+            {
+                ++m_CurLoc;
+                return *this;
+            }
+
+            Iterator& operator--()
+            {
+                --m_CurLoc;
+                return *this;
+            }
+
+            const T& operator*() { return m_pStorage[m_CurLoc & m_Mask]; }
+
+            friend bool operator==(const Iterator& lhs, const Iterator& rhs) { return lhs.m_CurLoc == rhs.m_CurLoc; }
+
+            friend bool operator!=(const Iterator& lhs, const Iterator& rhs) { return lhs.m_CurLoc != rhs.m_CurLoc; }
+        };
+
+        typedef T         value_type;
+        typedef Allocator allocator_type;
+        typedef T&        reference;
+        typedef const T&  const_reference;
+        typedef size_t    size_type;
+
+        DynamicQueue()
+            : DynamicQueue(Allocator())
+        {
+        }
+
+        explicit DynamicQueue(const Allocator& alloc)
+            : m_Allocator(alloc)
+            , m_pStorage(nullptr)
+            , m_Capacity(0)
+            , m_Head(0)
+            , m_Size(0)
+        {
+        }
+
+        /**
+         * Construct queue with storage for at least initialCapacity values.
+         * @param initialCapacity: Capacity to reserve, rounded up to a power of two.
+         * @param alloc: Allocator used for the ring storage.
+         */
+        explicit DynamicQueue(size_type initialCapacity, const Allocator& alloc = Allocator())
+            : DynamicQueue(alloc)
+        {
+            Reserve(initialCapacity);
+        }
+
+        DynamicQueue(const DynamicQueue& other)
+            : DynamicQueue(alloc_traits::select_on_container_copy_construction(other.m_Allocator))
+        {
+            copyFrom(other);
+        }
+
+        DynamicQueue(DynamicQueue&& other) noexcept
+            : m_Allocator(std::move(other.m_Allocator))
+            , m_pStorage(std::exchange(other.m_pStorage, nullptr))
+            , m_Capacity(std::exchange(other.m_Capacity, 0))
+            , m_Head(std::exchange(other.m_Head, 0))
+            , m_Size(std::exchange(other.m_Size, 0))
+        {
+        }
+
+        ~DynamicQueue() { release(); }
+
+        DynamicQueue& operator=(const DynamicQueue& other)
+        {
+            if (this != &other)
+            {
+                Clear();
+                if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+                {
+                    if (m_Allocator != other.m_Allocator)
+                    {
+                        release();
+                    }
+                    m_Allocator = other.m_Allocator;
+                }
+                copyFrom(other);
+            }
+
+            return *this;
+        }
+
+        DynamicQueue& operator=(DynamicQueue&& other) noexcept(
+            alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value)
+        {
+            if (this == &other)
+                return *this;
+
+            if constexpr (!alloc_traits::propagate_on_container_move_assignment::value)
+            {
+                if (m_Allocator != other.m_Allocator)
+                {
+                    // Storage cannot change hands, move the values individually.
+                    Clear();
+                    Reserve(other.m_Size);
+                    for (size_t i = 0; i < other.m_Size; ++i)
+                    {
+                        Push(std::move(other.at(i)));
+                    }
+                    other.Clear();
+                    return *this;
+                }
+            }
+
+            release();
+            if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+            {
+                m_Allocator = std::move(other.m_Allocator);
+            }
+            m_pStorage = std::exchange(other.m_pStorage, nullptr);
+            m_Capacity = std::exchange(other.m_Capacity, 0);
+            m_Head     = std::exchange(other.m_Head, 0);
+            m_Size     = std::exchange(other.m_Size, 0);
+
+            return *this;
+        }
+
+        [[nodiscard]] bool Full() const { return m_Size == MaxSize(); }
+
+        [[nodiscard]] bool Empty() const { return m_Size == 0; }
+
+        [[nodiscard]] size_type MaxSize() const { return alloc_traits::max_size(m_Allocator); }
+
+        [[nodiscard]] size_type Size() const { return m_Size; }
+
+        /**
+         * @return Number of values the queue can hold before the storage is reallocated.
+         */
+        [[nodiscard]] size_type Capacity() const { return m_Capacity; }
+
+        [[nodiscard]] allocator_type GetAllocator() const { return m_Allocator; }
+
+        bool Push(const_reference value)
+        {
+            Emplace(value);
+            return true;
+        }
+
+        bool Push(value_type&& value)
+        {
+            Emplace(std::move(value));
+            return true;
+        }
+
+        /**
+         * Construct a value in place at the back of the queue, growing the storage if required.
+         * The arguments may refer to values in the queue.
+         * @return Reference to the newly constructed value.
+         */
+        template <class... Args>
+        reference Emplace(Args&&... args)
+        {
+            if (m_Size == m_Capacity)
+            {
+                return growAndEmplace(std::forward<Args>(args)...);
+            }
+
+            pointer slot = m_pStorage + ((m_Head + m_Size) & (m_Capacity - 1));
+            alloc_traits::construct(m_Allocator, std::to_address(slot), std::forward<Args>(args)...);
+            ++m_Size;
+
+            return *slot;
+        }
+
+        bool Pop()
+        {
+            if (Empty())
+                return false;
+
+            alloc_traits::destroy(m_Allocator, std::to_address(m_pStorage + m_Head));
+            m_Head = (m_Head + 1) & (m_Capacity - 1);
+            --m_Size;
+            return true;
+        }
+
+        /**
+         * Destroy all values in the queue. The capacity is left unchanged.
+         */
+        void Clear()
+        {
+            while (Pop())
+            {
+            }
+            m_Head = 0;
+        }
+
+        /**
+         * Ensure the queue can hold at least capacity values without reallocating.
+         * @param capacity: Requested capacity, rounded up to a power of two.
+         * @throws std::length_error if the rounded capacity exceeds MaxSize().
+         */
+        void Reserve(size_type capacity)
+        {
+            if (capacity > m_Capacity)
+            {
+                relocate(roundUpPow2(capacity));
+            }
+        }
+
+        /**
+         * Reduce the capacity to the smallest power of two able to hold the current values.
+         */
+        void ShrinkToFit()
+        {
+            if (m_Size == 0)
+            {
+                release();
+                return;
+            }
+
+            size_t fitCapacity = roundUpPow2(m_Size);
+            if (fitCapacity < m_Capacity)
+            {
+                relocate(fitCapacity);
+            }
+        }
+
+        reference       Front() { return at(0); }
+        const_reference Front() const { return at(0); }
+        reference       Back() { return at(m_Size - 1); }
+        const_reference Back() const { return at(m_Size - 1); }
+
+        Iterator Begin() { return Iterator(m_pStorage, m_Capacity - 1, m_Head); }
+        Iterator End() { return Iterator(m_pStorage, m_Capacity - 1, m_Head + m_Size); }
+
+      private:
+        reference       at(size_t i) { return m_pStorage[(m_Head + i) & (m_Capacity - 1)]; }
+        const_reference at(size_t i) const { return m_pStorage[(m_Head + i) & (m_Capacity - 1)]; }
+
+        size_t roundUpPow2(size_t value) const
+        {
+            constexpr size_t maxPow2 = ~(~size_t(0) >> 1);
+            if (value > maxPow2 || std::bit_ceil(value) > MaxSize())
+            {
+                throw std::length_error("DynamicQueue capacity exceeds MaxSize().");
+            }
+
+            return std::bit_ceil(std::max(value, MinCapacity));
+        }
+
+        /**
+         * Move all values into a new buffer of newCapacity, unwrapping the ring so the head lands at index 0.
+         */
+        void relocate(size_t newCapacity)
+        {
+            pointer newStorage = alloc_traits::allocate(m_Allocator, newCapacity);
+            try
+            {
+                moveInto(newStorage);
+            }
+            catch (...)
+            {
+                alloc_traits::deallocate(m_Allocator, newStorage, newCapacity);
+                throw;
+            }
+
+            adopt(newStorage, newCapacity);
+        }
+
+        /**
+         * Double the capacity and append a value constructed from args.
+         * Like std::vector the new value is constructed before the old values are moved, so args may still refer
+         * to one of them.
+         */
+        template <class... Args>
+        reference growAndEmplace(Args&&... args)
+        {
+            size_t  newCapacity = roundUpPow2(m_Capacity + 1);
+            pointer newStorage  = alloc_traits::allocate(m_Allocator, newCapacity);
+            pointer slot        = newStorage + m_Size;
+            try
+            {
+                alloc_traits::construct(m_Allocator, std::to_address(slot), std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                alloc_traits::deallocate(m_Allocator, newStorage, newCapacity);
+                throw;
+            }
+
+            try
+            {
+                moveInto(newStorage);
+            }
+            catch (...)
+            {
+                alloc_traits::destroy(m_Allocator, std::to_address(slot));
+                alloc_traits::deallocate(m_Allocator, newStorage, newCapacity);
+                throw;
+            }
+
+            adopt(newStorage, newCapacity);
+            ++m_Size;
+
+            return *slot;
+        }
+
+        /**
+         * Move construct the values in order into newStorage. On failure the values moved so far are destroyed.
+         */
+        void moveInto(pointer newStorage)
+        {
+            T*     pDest    = std::to_address(newStorage);
+            size_t firstRun = std::min(m_Size, m_Capacity - m_Head);
+
+            std::uninitialized_move_n(std::to_address(m_pStorage + m_Head), firstRun, pDest);
+            try
+            {
+                std::uninitialized_move_n(std::to_address(m_pStorage), m_Size - firstRun, pDest + firstRun);
+            }
+            catch (...)
+            {
+                std::destroy_n(pDest, firstRun);
+                throw;
+            }
+        }
+
+        /**
+         * Destroy the moved from values and take ownership of newStorage holding the current values.
+         */
+        void adopt(pointer newStorage, size_t newCapacity)
+        {
+            size_t size = m_Size;
+            release();
+
+            m_pStorage = newStorage;
+            m_Capacity = newCapacity;
+            m_Size     = size;
+        }
+
+        void copyFrom(const DynamicQueue& other)
+        {
+            Reserve(other.m_Size);
+            for (size_t i = 0; i < other.m_Size; ++i)
+            {
+                Push(other.at(i));
+            }
+        }
+
+        void release()
+        {
+            Clear();
+            if (m_pStorage)
+            {
+                alloc_traits::deallocate(m_Allocator, m_pStorage, m_Capacity);
+            }
+            m_pStorage = nullptr;
+            m_Capacity = 0;
+        }
+    };
+
+    namespace pmr {
+        template <class T>
+        using DynamicQueue = Shared::DynamicQueue<T, std::pmr::polymorphic_allocator<T>>;
+    } // namespace pmr
+} // namespace Shared
@@ -1,4 +1,5 @@
 #include <array>
+#include <cstddef>
 #include <type_traits>
 namespace Shared {
     template <typename KeyT, typename ValueT, size_t Size, const std::array<std::pair<KeyT, ValueT>, Size>& Values>
@@ -0,0 +1,309 @@
+#pragma once
+
+#include <Serialize/FixedPoint.hpp>
+#include <Serialize/Int128.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace Shared {
+    /// <summary>
+    /// Signal processing kernels on FixedPoint arrays.
+    /// Products are summed exactly in a wide accumulator (int64_t, or Int128 when an operand has a 32 bit base type)
+    /// and only the final sum is rounded to the nearest step and saturated to the result type.
+    /// Types wider than 32 bits are not supported.
+    /// </summary>
+    class FixedPointDsp {
+      public:
+        template <class FIXED_TYPE>
+        using BaseType = std::remove_cv_t<decltype(FIXED_TYPE::MaxRawValue)>;
+
+        template <class LHS_TYPE, class RHS_TYPE>
+        using AccumulatorType =
+            std::conditional_t<(sizeof(BaseType<LHS_TYPE>) + sizeof(BaseType<RHS_TYPE>) <= 4), int64_t, Int128>;
+
+        /// <summary>
+        /// Sum of pLhs[i] * pRhs[i] with LHS_TYPE::GetFractionalBits() + RHS_TYPE::GetFractionalBits() fractional bits.
+        /// Arrays of 16 bit signed values are multiplied with SSE2 or AVX2 pmaddwd, 16 values at a time.
+        /// </summary>
+        template <class LHS_TYPE, class RHS_TYPE>
+        static AccumulatorType<LHS_TYPE, RHS_TYPE> DotProductRaw(const LHS_TYPE* pLhs, const RHS_TYPE* pRhs,
+                                                                 size_t count)
+        {
+            static_assert(LHS_TYPE::GetSize() <= 32 && RHS_TYPE::GetSize() <= 32,
+                          "FixedPointDsp supports FixedPoint types up to 32 bits.");
+
+            AccumulatorType<LHS_TYPE, RHS_TYPE> sum = 0;
+            size_t                              i{0};
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+            if constexpr (std::is_same_v<BaseType<LHS_TYPE>, int16_t> && std::is_same_v<BaseType<RHS_TYPE>, int16_t>)
+            {
+                sum = dotProductInt16(pLhs, pRhs, count, i);
+            }
+#endif
+            for (; i < count; ++i)
+            {
+                sum += static_cast<AccumulatorType<LHS_TYPE, RHS_TYPE>>(pLhs[i].ToIntegral()) *
+                       static_cast<AccumulatorType<LHS_TYPE, RHS_TYPE>>(pRhs[i].ToIntegral());
+            }
+            return sum;
+        }
+
+        /// <summary>
+        /// Dot product rounded once to RESULT_TYPE.
+        /// </summary>
+        template <class RESULT_TYPE, class LHS_TYPE, class RHS_TYPE>
+        static RESULT_TYPE DotProduct(const LHS_TYPE* pLhs, const RHS_TYPE* pRhs, size_t count)
+        {
+            return FromAccumulator<RESULT_TYPE>(DotProductRaw(pLhs, pRhs, count),
+                                                LHS_TYPE::GetFractionalBits() + RHS_TYPE::GetFractionalBits());
+        }
+
+        /// <summary>
+        /// Round an accumulated value with fracBits fractional bits to the nearest step of RESULT_TYPE.
+        /// </summary>
+        /// <returns>The rounded value, saturated to [GetMin(), GetMax()]</returns>
+        template <class RESULT_TYPE, class ACCUMULATOR_TYPE>
+        static constexpr RESULT_TYPE FromAccumulator(ACCUMULATOR_TYPE accumulator, size_t fracBits)
+        {
+            const ACCUMULATOR_TYPE maxRaw = static_cast<ACCUMULATOR_TYPE>(RESULT_TYPE::MaxRawValue);
+            const ACCUMULATOR_TYPE minRaw = static_cast<ACCUMULATOR_TYPE>(RESULT_TYPE::MinRawValue);
+
+            size_t resultFracBits = RESULT_TYPE::GetFractionalBits();
+            if (fracBits > resultFracBits)
+            {
+                size_t shift = fracBits - resultFracBits;
+                accumulator  = (accumulator + (static_cast<ACCUMULATOR_TYPE>(1) << (shift - 1))) >> shift;
+            }
+            else if (fracBits < resultFracBits)
+            {
+                size_t shift = resultFracBits - fracBits;
+                if (accumulator > (maxRaw >> shift))
+                {
+                    return RESULT_TYPE::FromRaw(RESULT_TYPE::MaxRawValue);
+                }
+                if (accumulator < (minRaw >> shift))
+                {
+                    return RESULT_TYPE::FromRaw(RESULT_TYPE::MinRawValue);
+                }
+                accumulator = accumulator << shift;
+            }
+
+            if (accumulator > maxRaw)
+            {
+                return RESULT_TYPE::FromRaw(RESULT_TYPE::MaxRawValue);
+            }
+            if (accumulator < minRaw)
+            {
+                return RESULT_TYPE::FromRaw(RESULT_TYPE::MinRawValue);
+            }
+            return RESULT_TYPE::FromRaw(static_cast<BaseType<RESULT_TYPE>>(accumulator));
+        }
+
+      private:
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        /// <summary>
+        /// Vectorized part of DotProductRaw() for 16 bit signed values, FixedPoint has the layout of its raw value.
+        /// pmaddwd sums pairs of products into 32 bits, which are widened to 64 bit accumulators right away.
+        /// The only pair that does not fit is (-32768 * -32768) * 2 = 2^31, which wraps to INT32_MIN. No other
+        /// pair reaches INT32_MIN, so that lane is widened as +2^31 instead of being sign extended.
+        /// </summary>
+        /// <param name="index">Set to the number of values that were processed</param>
+        template <class LHS_TYPE, class RHS_TYPE>
+        static int64_t dotProductInt16(const LHS_TYPE* pLhs, const RHS_TYPE* pRhs, size_t count, size_t& index)
+        {
+            static_assert(sizeof(LHS_TYPE) == sizeof(int16_t) && sizeof(RHS_TYPE) == sizeof(int16_t));
+
+            int64_t sum{0};
+            size_t  i{0};
+#if defined(__AVX2__)
+            const __m256i wrappedWidePairs = _mm256_set1_epi32(INT32_MIN);
+            __m256i       wideSums         = _mm256_setzero_si256();
+            for (; i + 16 <= count; i += 16)
+            {
+                __m256i pairs = _mm256_madd_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pLhs + i)),
+                                                  _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pRhs + i)));
+                __m256i signs = _mm256_andnot_si256(_mm256_cmpeq_epi32(pairs, wrappedWidePairs),
+                                                    _mm256_srai_epi32(pairs, 31));
+                wideSums      = _mm256_add_epi64(wideSums, _mm256_unpacklo_epi32(pairs, signs));
+                wideSums      = _mm256_add_epi64(wideSums, _mm256_unpackhi_epi32(pairs, signs));
+            }
+
+            alignas(32) int64_t wideLanes[4];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(wideLanes), wideSums);
+            sum = wideLanes[0] + wideLanes[1] + wideLanes[2] + wideLanes[3];
+#endif
+            const __m128i wrappedPairs = _mm_set1_epi32(INT32_MIN);
+            __m128i       sums         = _mm_setzero_si128();
+            for (; i + 8 <= count; i += 8)
+            {
+                __m128i pairs = _mm_madd_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pLhs + i)),
+                                               _mm_loadu_si128(reinterpret_cast<const __m128i*>(pRhs + i)));
+                __m128i signs = _mm_andnot_si128(_mm_cmpeq_epi32(pairs, wrappedPairs), _mm_srai_epi32(pairs, 31));
+                sums          = _mm_add_epi64(sums, _mm_unpacklo_epi32(pairs, signs));
+                sums          = _mm_add_epi64(sums, _mm_unpackhi_epi32(pairs, signs));
+            }
+
+            alignas(16) int64_t lanes[2];
+            _mm_store_si128(reinterpret_cast<__m128i*>(lanes), sums);
+            index = i;
+            return sum + lanes[0] + lanes[1];
+        }
+#endif
+    };
+
+    /// <summary>
+    /// FIR filter y[n] = sum(c[k] * x[n - k]) over blocks of samples.
+    /// The last GetNumTaps() - 1 input samples are carried over, so consecutive blocks filter like one long signal.
+    /// Each output is accumulated exactly and rounded once, see FixedPointDsp.
+    /// </summary>
+    template <class SAMPLE_TYPE, class COEFFICIENT_TYPE>
+    class FirFilter {
+      public:
+        /// <param name="pCoefficients">c[0] to c[numTaps - 1], applied to the newest to the oldest sample</param>
+        FirFilter(const COEFFICIENT_TYPE* pCoefficients, size_t numTaps)
+            : m_Coefficients(pCoefficients, pCoefficients + numTaps)
+        {
+            assert(numTaps > 0);
+            m_Samples.resize(numTaps - 1);
+
+            // Reversed so each output is a dot product over consecutive samples.
+            std::reverse(m_Coefficients.begin(), m_Coefficients.end());
+        }
+
+        size_t GetNumTaps() const { return m_Coefficients.size(); }
+
+        /// <summary>
+        /// Forget the carried over samples, as if the signal had been 0 so far.
+        /// </summary>
+        void Reset() { std::fill(m_Samples.begin(), m_Samples.end(), SAMPLE_TYPE()); }
+
+        /// <summary>
+        /// Filter count samples, pOutput may be the same array as pInput.
+        /// </summary>
+        void Process(const SAMPLE_TYPE* pInput, SAMPLE_TYPE* pOutput, size_t count)
+        {
+            size_t history = m_Coefficients.size() - 1;
+            m_Samples.insert(m_Samples.end(), pInput, pInput + count);
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                pOutput[i] = FixedPointDsp::FromAccumulator<SAMPLE_TYPE>(
+                    FixedPointDsp::DotProductRaw(m_Coefficients.data(), m_Samples.data() + i, m_Coefficients.size()),
+                    COEFFICIENT_TYPE::GetFractionalBits() + SAMPLE_TYPE::GetFractionalBits());
+            }
+
+            // Keep the newest samples, the capacity is reused by the next block.
+            std::copy(m_Samples.end() - history, m_Samples.end(), m_Samples.begin());
+            m_Samples.erase(m_Samples.begin() + history, m_Samples.end());
+        }
+
+      private:
+        std::vector<COEFFICIENT_TYPE> m_Coefficients;
+        std::vector<SAMPLE_TYPE>      m_Samples;
+    };
+
+    /// <summary>
+    /// Cascade of second order IIR sections in direct form I:
+    /// y[n] = b0 * x[n] + b1 * x[n - 1] + b2 * x[n - 2] - a1 * y[n - 1] - a2 * y[n - 2]
+    /// Each output is accumulated exactly and rounded once, the state keeps the rounded and saturated outputs.
+    /// Coefficients of stable sections reach +-2, so COEFFICIENT_TYPE needs at least 2 signed integer bits.
+    /// The recursion is inherently serial, so sections are processed one block at a time without SIMD.
+    /// </summary>
+    template <class SAMPLE_TYPE, class COEFFICIENT_TYPE>
+    class BiquadCascade {
+      public:
+        struct Section
+        {
+            COEFFICIENT_TYPE B0;
+            COEFFICIENT_TYPE B1;
+            COEFFICIENT_TYPE B2;
+            COEFFICIENT_TYPE A1;
+            COEFFICIENT_TYPE A2;
+        };
+
+        explicit BiquadCascade(std::vector<Section> sections)
+            : m_Sections(std::move(sections))
+            , m_States(m_Sections.size())
+        {
+        }
+
+        size_t GetNumSections() const { return m_Sections.size(); }
+
+        /// <summary>
+        /// Clear the state of all sections.
+        /// </summary>
+        void Reset() { std::fill(m_States.begin(), m_States.end(), State()); }
+
+        /// <summary>
+        /// Filter count samples through all sections, pOutput may be the same array as pInput.
+        /// </summary>
+        void Process(const SAMPLE_TYPE* pInput, SAMPLE_TYPE* pOutput, size_t count)
+        {
+            for (size_t section = 0; section < m_Sections.size(); ++section)
+            {
+                processSection(m_Sections[section], m_States[section], section == 0 ? pInput : pOutput, pOutput, count);
+            }
+            if (m_Sections.empty() && pInput != pOutput)
+            {
+                std::copy(pInput, pInput + count, pOutput);
+            }
+        }
+
+      private:
+        typedef FixedPointDsp::AccumulatorType<COEFFICIENT_TYPE, SAMPLE_TYPE> accumulatorType;
+
+        struct State
+        {
+            SAMPLE_TYPE X1;
+            SAMPLE_TYPE X2;
+            SAMPLE_TYPE Y1;
+            SAMPLE_TYPE Y2;
+        };
+
+        static accumulatorType product(COEFFICIENT_TYPE coefficient, SAMPLE_TYPE sample)
+        {
+            return static_cast<accumulatorType>(coefficient.ToIntegral()) *
+                   static_cast<accumulatorType>(sample.ToIntegral());
+        }
+
+        static void processSection(
+            const Section& section, State& state, const SAMPLE_TYPE* pInput, SAMPLE_TYPE* pOutput, size_t count)
+        {
+            constexpr size_t fracBits = COEFFICIENT_TYPE::GetFractionalBits() + SAMPLE_TYPE::GetFractionalBits();
+
+            // Work on locals so the state stays in registers.
+            State current = state;
+            for (size_t i = 0; i < count; ++i)
+            {
+                SAMPLE_TYPE     input       = pInput[i];
+                accumulatorType accumulator = product(section.B0, input) + product(section.B1, current.X1) +
+                                              product(section.B2, current.X2) - product(section.A1, current.Y1) -
+                                              product(section.A2, current.Y2);
+                SAMPLE_TYPE output = FixedPointDsp::FromAccumulator<SAMPLE_TYPE>(accumulator, fracBits);
+
+                current.X2 = current.X1;
+                current.X1 = input;
+                current.Y2 = current.Y1;
+                current.Y1 = output;
+                pOutput[i] = output;
+            }
+            state = current;
+        }
+
+        std::vector<Section> m_Sections;
+        std::vector<State>   m_States;
+    };
+} // namespace Shared
@@ -0,0 +1,504 @@
+#pragma once
+
+#include <Serialize/FixedPoint.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+#include <type_traits>
+
+namespace Shared {
+    /// <summary>
+    /// Constants used by FixedPointMath and the generators of its compile time tables, all with 30 fractional bits.
+    /// </summary>
+    class FixedPointMathTables {
+      protected:
+        static constexpr int64_t WorkBits = 30;
+        static constexpr int64_t WorkOne  = int64_t(1) << WorkBits;
+
+        static constexpr int64_t CordicIterations = WorkBits;
+        static constexpr int64_t SineTableBits    = 8;
+        static constexpr int64_t ExpTableBits     = 6;
+
+        /// <summary>
+        /// Round to nearest, halves away from zero.
+        /// </summary>
+        static constexpr int64_t toWork(double value)
+        {
+            double scaled = value * static_cast<double>(WorkOne);
+            return static_cast<int64_t>(scaled < 0 ? scaled - 0.5 : scaled + 0.5);
+        }
+
+        // 2 * pi and ln(2) with 60 fractional bits, split into the 30 bit working value and the 30 bits below.
+        static constexpr int64_t WorkTwoPi = 0x1921FB544LL;
+        static constexpr int64_t TwoPiLow  = 0x10B4611ALL;
+        static constexpr int64_t WorkPi    = WorkTwoPi / 2;
+        static constexpr int64_t WorkLn2   = 0x2C5C85FDLL;
+        static constexpr int64_t Ln2Low    = 0x3D1CF79ALL;
+
+        // 2 / pi with 30 fractional bits.
+        static constexpr int64_t QuarterTurnsPerRadian = 0x28BE60DCLL;
+
+        static constexpr double taylorSin(double x)
+        {
+            double term = x;
+            double sum  = x;
+            for (int i = 1; i < 20; ++i)
+            {
+                term *= -x * x / ((2 * i) * (2 * i + 1));
+                sum += term;
+            }
+            return sum;
+        }
+
+        static constexpr double taylorExp(double x)
+        {
+            double term = 1;
+            double sum  = 1;
+            for (int i = 1; i < 30; ++i)
+            {
+                term *= x / i;
+                sum += term;
+            }
+            return sum;
+        }
+
+        static constexpr double taylorAtan(double x)
+        {
+            if (x == 1.0)
+            {
+                return std::numbers::pi / 4;
+            }
+
+            double power = x;
+            double sum   = 0;
+            for (int i = 0; i < 100; ++i)
+            {
+                sum += ((i % 2 == 0) ? power : -power) / (2 * i + 1);
+                power *= x * x;
+            }
+            return sum;
+        }
+
+        static constexpr std::array<int64_t, CordicIterations> makeAtanTable()
+        {
+            std::array<int64_t, CordicIterations> table{};
+            double                                x = 1.0;
+            for (auto& angle : table)
+            {
+                angle = toWork(taylorAtan(x));
+                x /= 2;
+            }
+            return table;
+        }
+
+        /// <summary>
+        /// Product of cos(atan(2^-i)), CORDIC rotations scale the vector by its inverse.
+        /// </summary>
+        static constexpr int64_t makeCordicGain()
+        {
+            double gain = 1.0;
+            double x    = 1.0;
+            for (int64_t i = 0; i < CordicIterations; ++i)
+            {
+                // 1 / sqrt(1 + x^2) by Newton iterations, starting at 1 which is above the result.
+                double square      = 1 + x * x;
+                double inverseRoot = 1.0;
+                for (int j = 0; j < 50; ++j)
+                {
+                    inverseRoot = inverseRoot * (3 - square * inverseRoot * inverseRoot) / 2;
+                }
+                gain *= inverseRoot;
+                x /= 2;
+            }
+            return toWork(gain);
+        }
+
+        static constexpr std::array<int64_t, (1 << SineTableBits) + 1> makeSineTable()
+        {
+            std::array<int64_t, (1 << SineTableBits) + 1> table{};
+            for (size_t i = 0; i < table.size(); ++i)
+            {
+                table[i] = toWork(taylorSin(std::numbers::pi / 2 * static_cast<double>(i) / (1 << SineTableBits)));
+            }
+            return table;
+        }
+
+        static constexpr std::array<int64_t, (1 << ExpTableBits)> makeExpTable()
+        {
+            std::array<int64_t, (1 << ExpTableBits)> table{};
+            for (size_t i = 0; i < table.size(); ++i)
+            {
+                table[i] = toWork(taylorExp(static_cast<double>(i) / (1 << ExpTableBits)));
+            }
+            return table;
+        }
+    };
+
+    /// <summary>
+    /// Math functions evaluated directly on FixedPoint values, without converting to double.
+    /// Internally values are carried with 30 fractional bits in 64 bit integers, so the error bounds below are
+    /// relative to that precision and the result is then rounded to the step size of the FixedPoint type.
+    /// Results outside the range of the type saturate. Types wider than 32 bits are not supported.
+    /// All tables are generated at compile time.
+    /// </summary>
+    class FixedPointMath : private FixedPointMathTables {
+      public:
+        /// <summary>
+        /// Square root, computed bit by bit on the raw value and correctly rounded.
+        /// </summary>
+        /// <returns>sqrt(value) within half a step, 0 for negative values</returns>
+        template <class BASE_TYPE, size_t INT_BITS, size_t FRAC_BITS>
+        static constexpr FixedPoint<BASE_TYPE, INT_BITS, FRAC_BITS> Sqrt(
+            FixedPoint<BASE_TYPE, INT_BITS, FRAC_BITS> value)
+        {
+            typedef FixedPoint<BASE_TYPE, INT_BITS, FRAC_BITS> fixedPointType;
+
+            if (value.ToIntegral() <= 0)
+            {
+                return fixedPointType::FromRaw(0);
+            }
+
+            // sqrt(raw / 2^F) * 2^F == sqrt(raw * 2^F), which fits 64 bits as INT_BITS + FRAC_BITS <= 32.
+            uint64_t radicand = static_cast<uint64_t>(value.ToIntegral()) << FRAC_BITS;
+            uint64_t root     = integerSqrt(radicand);
+            if (radicand - root * root > root)
+            {
+                ++root;
+            }
+
+            return fixedPointType::FromRaw(saturate<fixedPointType>(static_cast<int64_t>(root)));
+        }
+
+        /// <summary>
+        /// Sine of an angle in radians, computed with CORDIC rotations.
+        /// Error before rounding is below an eighth of a step or 2^-26, independent of the magnitude of the angle.
+        /// </summary>
+        template <class BASE_TYPE, size_t INT_BITS, size_t FRAC_BITS>
+        static constexpr FixedPoint<BASE_TYPE, INT_BITS, FRAC_BITS> Sin(
+            FixedPoint<BASE_TYPE, INT_BITS, FRAC_BITS> angle)
+        {
+            int64_t sine;
+            int64_t cosine;
+            cordicRotate(reduceAngle(toWork(angle)), cordicIterations(FRAC_BITS), sine, cosine);
+            return fromWork<decltype(angle)>(sine);
+        }
+
+        /// <summary>
+        /// Cosine of an angle in radians, computed with CORDIC rotations.
+        /// Error before rounding is below an eighth of a step or 2^-26, independent of the magnitude of the angle.
+        /// </summary>
+        template <class BASE_TYPE, size_t INT_BITS, size_t FRAC_BITS>
+        static constexpr FixedPoint<BASE_TYPE, INT_BITS, FRAC_BITS> Cos(
+            FixedPoint<BASE_TYPE, INT_BITS, FRAC_BITS> angle)
+        {
+            int64_t sine;
+            int64_t cosine;
+            cordicRotate(reduceAngle(toWork(angle)), cordicIterations(FRAC_BITS), sine, cosine);
+            return fromWork<decltype(angle)>(cosine);
+        }
+
+        /// <summary>
+        /// Sine of an angle in radians, interpolated linearly in a 256 entry quarter wave table.
+        /// Faster than Sin() but the error before rounding is up to 5e-6, within one step for FRAC_BITS <= 16.
+        /// </summary>
+        template <class BASE_TYPE, size_t INT_BITS, size_t FRAC_BITS>
+        static constexpr FixedPoint<BASE_TYPE, INT_BITS, FRAC_BITS> SinLookup(
+            FixedPoint<BASE_TYPE, INT_BITS, FRAC_BITS> angle)
+        {
+            return fromWork<decltype(angle)>(sineLookup(reduceAngle(toWork(angle)) + WorkPi / 2 * 3));
+        }
+
+        /// <summary>
+        /// Cosine of an angle in radians, interpolated linearly in a 256 entry quarter wave table.
+        /// Faster than Cos() but the error before rounding is up to 5e-6, within one step for FRAC_BITS <= 16.
+        /// </summary>
+        template <class BASE_TYPE, size_t INT_BITS, size_t FRAC_BITS>
+        static constexpr FixedPoint<BASE_TYPE, INT_BITS, FRAC_BITS> CosLookup(
+            FixedPoint<BASE_TYPE, INT_BITS, FRAC_BITS> angle)
+        {
+            return fromWork<decltype(angle)>(sineLookup(reduceAngle(toWork(angle)) + WorkTwoPi));
+        }
+
+        /// <summary>
+        /// Angle of the vector (x, y) in radians within [-pi, pi], computed with CORDIC vectoring.
+        /// Error before rounding is below an eighth of a step or 2^-26.
+        /// Types with less than 3 signed integer bits saturate near +-pi.
+        /// </summary>
+        /// <returns>atan2(y, x), 0 if both are 0</returns>
+        template <class BASE_TYPE, size_t INT_BITS, size_t FRAC_BITS>
+        static constexpr FixedPoint<BASE_TYPE, INT_BITS, FRAC_BITS> Atan2(FixedPoint<BASE_TYPE, INT_BITS, FRAC_BITS> y,
+                                                                          FixedPoint<BASE_TYPE, INT_BITS, FRAC_BITS> x)
+        {
+            return fromWork<decltype(y)>(cordicVector(y.ToIntegral(), x.ToIntegral(), cordicIterations(FRAC_BITS)));
+        }
+
+        /// <summary>
+        /// e^value, from 2^n times a 64 entry table of e^(i/64) and a quartic polynomial for the remainder.
+        /// Relative error before rounding is below 2^-28.
+        /// </summary>
+        template <class BASE_TYPE, size_t INT_BITS, size_t FRAC_BITS>
+        static constexpr FixedPoint<BASE_TYPE, INT_BITS, FRAC_BITS> Exp(
+            FixedPoint<BASE_TYPE, INT_BITS, FRAC_BITS> value)
+        {
+            typedef FixedPoint<BASE_TYPE, INT_BITS, FRAC_BITS> fixedPointType;
+
+            // Results below half a step round to 0 and results above 2^32 saturate for any type.
+            int64_t x = toWork(value);
+            if (x < -WorkLn2 * static_cast<int64_t>(FRAC_BITS + 2))
+            {
+                return fixedPointType::FromRaw(0);
+            }
+            if (x > WorkLn2 * 33)
+            {
+                return fixedPointType::FromRaw(fixedPointType::MaxRawValue);
+            }
+
+            // x = n * ln(2) + r with r in [0, ln(2)), ln(2) carries 30 extra bits so r stays accurate.
+            int64_t n = x / WorkLn2 - ((x < 0) ? 1 : 0);
+            int64_t r = reduceLn2(x, n);
+            while (r < 0)
+            {
+                r = reduceLn2(x, --n);
+            }
+            while (r >= WorkLn2)
+            {
+                r = reduceLn2(x, ++n);
+            }
+
+            // r = i / 64 + t, e^t = 1 + t(1 + t/2(1 + t/3(1 + t/4))).
+            int64_t index = r >> (WorkBits - ExpTableBits);
+            int64_t t     = r - (index << (WorkBits - ExpTableBits));
+            int64_t poly  = WorkOne + t / 4;
+            poly          = WorkOne + ((t * poly) >> WorkBits) / 3;
+            poly          = WorkOne + ((t * poly) >> WorkBits) / 2;
+            poly          = WorkOne + ((t * poly) >> WorkBits);
+
+            int64_t mantissa = (ExpTable[static_cast<size_t>(index)] * poly) >> WorkBits;
+
+            // mantissa * 2^n in the raw format, mantissa < 2^31 so shifts up to 32 fit.
+            int64_t shift = n + static_cast<int64_t>(FRAC_BITS) - WorkBits;
+            if (shift >= 0)
+            {
+                if (shift > 32 || mantissa > (static_cast<int64_t>(fixedPointType::MaxRawValue) >> shift))
+                {
+                    return fixedPointType::FromRaw(fixedPointType::MaxRawValue);
+                }
+                return fixedPointType::FromRaw(static_cast<BASE_TYPE>(mantissa << shift));
+            }
+            if (shift < -WorkBits - 1)
+            {
+                return fixedPointType::FromRaw(0);
+            }
+            return fixedPointType::FromRaw(saturate<fixedPointType>(roundShiftRight(mantissa, -shift)));
+        }
+
+      private:
+        static constexpr std::array<int64_t, CordicIterations>         AtanTable  = makeAtanTable();
+        static constexpr int64_t                                       CordicGain = makeCordicGain();
+        static constexpr std::array<int64_t, (1 << SineTableBits) + 1> SineTable  = makeSineTable();
+        static constexpr std::array<int64_t, (1 << ExpTableBits)>      ExpTable   = makeExpTable();
+
+        static constexpr int64_t roundShiftRight(int64_t value, int64_t shift)
+        {
+            return (value + (int64_t(1) << (shift - 1))) >> shift;
+        }
+
+        /// <summary>
+        /// Raw value rescaled to 30 fractional bits, INT_BITS + FRAC_BITS <= 32 so this can't overflow.
+        /// </summary>
+        template <class BASE_TYPE, size_t INT_BITS, size_t FRAC_BITS>
+        static constexpr int64_t toWork(FixedPoint<BASE_TYPE, INT_BITS, FRAC_BITS> value)
+        {
+            int64_t raw = static_cast<int64_t>(value.ToIntegral());
+            if constexpr (FRAC_BITS <= WorkBits)
+            {
+                return raw * (int64_t(1) << (WorkBits - static_cast<int64_t>(FRAC_BITS)));
+            }
+            else
+            {
+                return roundShiftRight(raw, static_cast<int64_t>(FRAC_BITS) - WorkBits);
+            }
+        }
+
+        template <class FIXED_TYPE>
+        static constexpr std::remove_cv_t<decltype(FIXED_TYPE::MaxRawValue)> saturate(int64_t raw)
+        {
+            static_assert(FIXED_TYPE::GetSize() <= 32, "FixedPointMath supports FixedPoint types up to 32 bits.");
+
+            if (raw > static_cast<int64_t>(FIXED_TYPE::MaxRawValue))
+            {
+                return FIXED_TYPE::MaxRawValue;
+            }
+            if (raw < static_cast<int64_t>(FIXED_TYPE::MinRawValue))
+            {
+                return FIXED_TYPE::MinRawValue;
+            }
+            return static_cast<std::remove_cv_t<decltype(FIXED_TYPE::MaxRawValue)>>(raw);
+        }
+
+        /// <summary>
+        /// Working value rounded to the raw format of FIXED_TYPE.
+        /// </summary>
+        template <class FIXED_TYPE>
+        static constexpr FIXED_TYPE fromWork(int64_t value)
+        {
+            constexpr int64_t fracBits = static_cast<int64_t>(FIXED_TYPE::GetFractionalBits());
+            if constexpr (fracBits >= WorkBits)
+            {
+                return FIXED_TYPE::FromRaw(saturate<FIXED_TYPE>(value * (int64_t(1) << (fracBits - WorkBits))));
+            }
+            else
+            {
+                return FIXED_TYPE::FromRaw(saturate<FIXED_TYPE>(roundShiftRight(value, WorkBits - fracBits)));
+            }
+        }
+
+        static constexpr uint64_t integerSqrt(uint64_t value)
+        {
+            uint64_t root = 0;
+            uint64_t bit  = uint64_t(1) << ((63 - std::countl_zero(value)) & ~1);
+            while (bit != 0)
+            {
+                uint64_t mask = (value >= root + bit) ? ~uint64_t(0) : 0;
+                value -= (root + bit) & mask;
+                root = (root >> 1) + (bit & mask);
+                bit >>= 2;
+            }
+            return root;
+        }
+
+        static constexpr int64_t reduceLn2(int64_t x, int64_t n)
+        {
+            return x - n * WorkLn2 - ((n * Ln2Low) >> WorkBits);
+        }
+
+        /// <summary>
+        /// Reduce an angle to [-pi, pi). 2 * pi carries 30 extra bits so large angles stay accurate.
+        /// </summary>
+        static constexpr int64_t reduceAngle(int64_t angle)
+        {
+            int64_t turns = angle / WorkTwoPi;
+            int64_t reduced = angle - turns * WorkTwoPi - ((turns * TwoPiLow) >> WorkBits);
+            while (reduced >= WorkPi)
+            {
+                reduced -= WorkTwoPi;
+            }
+            while (reduced < -WorkPi)
+            {
+                reduced += WorkTwoPi;
+            }
+            return reduced;
+        }
+
+        /// <summary>
+        /// Each iteration adds about one bit, stop an eighth of a step below the result precision.
+        /// </summary>
+        static constexpr int64_t cordicIterations(size_t fracBits)
+        {
+            return std::min(CordicIterations, static_cast<int64_t>(fracBits) + 4);
+        }
+
+        /// <summary>
+        /// Rotate (gain, 0) by angle, which has to be within [-pi, pi).
+        /// </summary>
+        static constexpr void cordicRotate(int64_t angle, int64_t iterations, int64_t& sine, int64_t& cosine)
+        {
+            // CORDIC converges for angles up to ~1.74, rotate by pi first and negate the result otherwise.
+            bool negate = false;
+            if (angle > WorkPi / 2)
+            {
+                angle -= WorkPi;
+                negate = true;
+            }
+            else if (angle < -WorkPi / 2)
+            {
+                angle += WorkPi;
+                negate = true;
+            }
+
+            int64_t x = CordicGain;
+            int64_t y = 0;
+            // The rotation direction is unpredictable, apply it through a sign mask instead of a branch.
+            for (int64_t i = 0; i < iterations; ++i)
+            {
+                int64_t sign = angle >> 63;
+                int64_t dx   = y >> i;
+                int64_t dy   = x >> i;
+                x -= (dx ^ sign) - sign;
+                y += (dy ^ sign) - sign;
+                angle -= (AtanTable[static_cast<size_t>(i)] ^ sign) - sign;
+            }
+
+            sine   = negate ? -y : y;
+            cosine = negate ? -x : x;
+        }
+
+        /// <summary>
+        /// Rotate (x, y) onto the x axis.
+        /// </summary>
+        /// <returns>Accumulated angle, atan2(y, x)</returns>
+        static constexpr int64_t cordicVector(int64_t y, int64_t x, int64_t iterations)
+        {
+            if (x == 0 && y == 0)
+            {
+                return 0;
+            }
+
+            // Only the direction matters, scale up so the shifts keep 60 significant bits.
+            uint64_t magnitude = static_cast<uint64_t>(x < 0 ? -x : x) | static_cast<uint64_t>(y < 0 ? -y : y);
+            int      scale     = std::countl_zero(magnitude) - 3;
+            x *= int64_t(1) << scale;
+            y *= int64_t(1) << scale;
+
+            int64_t angle = 0;
+            if (x < 0)
+            {
+                angle = (y < 0) ? -WorkPi : WorkPi;
+                x     = -x;
+                y     = -y;
+            }
+
+            for (int64_t i = 0; i < iterations; ++i)
+            {
+                int64_t sign = (y > 0) ? 0 : -1;
+                int64_t dx   = y >> i;
+                int64_t dy   = x >> i;
+                x += (dx ^ sign) - sign;
+                y -= (dy ^ sign) - sign;
+                angle += (AtanTable[static_cast<size_t>(i)] ^ sign) - sign;
+            }
+
+            return angle;
+        }
+
+        /// <summary>
+        /// Interpolated sine of phase - 3/2 pi, the offset keeps the phase of reduced angles positive.
+        /// </summary>
+        static constexpr int64_t sineLookup(int64_t phase)
+        {
+            // The angle in quarter turns is quarterTurns - 3, the fraction of a quarter turn keeps 30 bits.
+            int64_t quarterTurns = (phase * QuarterTurnsPerRadian) >> WorkBits;
+            int64_t quadrant     = ((quarterTurns >> WorkBits) + 1) & 3;
+            int64_t fraction     = quarterTurns & (WorkOne - 1);
+            if (quadrant & 1)
+            {
+                fraction = WorkOne - fraction;
+            }
+
+            constexpr int64_t weightBits = WorkBits - SineTableBits;
+            size_t            index      = static_cast<size_t>(fraction >> weightBits);
+            int64_t           weight     = fraction & ((int64_t(1) << weightBits) - 1);
+            int64_t           value      = SineTable[index];
+            if (weight != 0)
+            {
+                value += ((SineTable[index + 1] - value) * weight) >> weightBits;
+            }
+
+            return (quadrant & 2) ? -value : value;
+        }
+    };
+} // namespace Shared
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "SerializeDeserializeNum.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <type_traits>
+
+namespace Shared
+{
+    /**
+     * Non-owning view over a serialized array of arithmatic values.
+     * Values are decoded lazily as they are accessed, so scanning a payload does not allocate or copy.
+     * The underlying buffer must outlive the view.
+     * @tparam T: Type of the serialized values.
+     * @tparam endianess: Endianess the values were serialized with.
+     */
+    template<class T, Endianess endianess = Endianess::LittleEndian>
+    class ArithmaticArrayView : public std::ranges::view_interface<ArithmaticArrayView<T, endianess>>
+    {
+      public:
+        class Iterator
+        {
+            const std::byte* m_pCurLoc;
+
+          public:
+            using iterator_concept  = std::random_access_iterator_tag;
+            using iterator_category = std::input_iterator_tag;
+            using value_type        = T;
+            using difference_type   = std::ptrdiff_t;
+
+            Iterator()
+                : m_pCurLoc(nullptr)
+            {
+            }
+
+            explicit Iterator(const std::byte* pLoc)
+                : m_pCurLoc(pLoc)
+            {
+            }
+
+            T operator*() const
+            {
+                T value;
+                DeSerializeArithmaticArray<T, std::byte, endianess>(m_pCurLoc, 1, &value);
+                return value;
+            }
+
+            T operator[](difference_type n) const { return *(*this + n); }
+
+            Iterator& operator++()
+            {
+                m_pCurLoc += sizeof(T);
+                return *this;
+            }
+
+            Iterator operator++(int)
+            {
+                Iterator old(*this);
+                ++*this;
+                return old;
+            }
+
+            Iterator& operator--()
+            {
+                m_pCurLoc -= sizeof(T);
+                return *this;
+            }
+
+            Iterator operator--(int)
+            {
+                Iterator old(*this);
+                --*this;
+                return old;
+            }
+
+            Iterator& operator+=(difference_type n)
+            {
+                m_pCurLoc += n * static_cast<difference_type>(sizeof(T));
+                return *this;
+            }
+
+            Iterator& operator-=(difference_type n)
+            {
+                m_pCurLoc -= n * static_cast<difference_type>(sizeof(T));
+                return *this;
+            }
+
+            friend Iterator operator+(Iterator it, difference_type n) { return it += n; }
+            friend Iterator operator+(difference_type n, Iterator it) { return it += n; }
+            friend Iterator operator-(Iterator it, difference_type n) { return it -= n; }
+
+            friend difference_type operator-(const Iterator& lhs, const Iterator& rhs)
+            {
+                return (lhs.m_pCurLoc - rhs.m_pCurLoc) / static_cast<difference_type>(sizeof(T));
+            }
+
+            friend bool operator==(const Iterator& lhs, const Iterator& rhs) { return lhs.m_pCurLoc == rhs.m_pCurLoc; }
+            friend auto operator<=>(const Iterator& lhs, const Iterator& rhs)
+            {
+                return lhs.m_pCurLoc <=> rhs.m_pCurLoc;
+            }
+        };
+
+        ArithmaticArrayView()
+            : m_Bytes()
+        {
+        }
+
+        /**
+         * Construct view over serialized values.
+         * @param bytes: Serialized values, size must be a multiple of sizeof(T).
+         */
+        explicit ArithmaticArrayView(std::span<const std::byte> bytes)
+            : m_Bytes(bytes)
+        {
+            static_assert(std::is_arithmetic<T>::value, "T must be arithmatic type.");
+        }
+
+        Iterator begin() const { return Iterator(m_Bytes.data()); }
+        Iterator end() const { return Iterator(m_Bytes.data() + m_Bytes.size()); }
+
+        size_t size() const { return m_Bytes.size() / sizeof(T); }
+
+        /**
+         * @return Raw serialized bytes backing the view.
+         */
+        std::span<const std::byte> GetBytes() const { return m_Bytes; }
+
+      private:
+        std::span<const std::byte> m_Bytes;
+    };
+} // namespace Shared
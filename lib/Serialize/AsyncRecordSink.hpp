@@ -0,0 +1,563 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
+// Internal, undefined again at the end of this header.
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define SHARED_ASYNC_RECORD_SINK_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif
+
+namespace Shared {
+    /**
+     * Asynchronous sink for serialized records.
+     * The sink owns a fixed set of record buffers. Callers acquire a buffer, serialize a record into it (for
+     * example with BinaryWriter<unsigned char*> over RecordBuffer::Bytes) and submit it. Submitted buffers
+     * are appended to the file in submission order and handed back for reuse once the write completes, so
+     * serializing the next record overlaps with disk I/O.
+     *
+     * On Linux the writes go through io_uring, submitted in batches and using registered (fixed) buffers when
+     * the kernel allows it. When io_uring is unavailable or the descriptor is not seekable, each buffer is
+     * written synchronously on Submit() instead. The writes do not move the file position, Flush() moves it
+     * past the last record so the descriptor can be written to afterwards. The class is not thread safe.
+     * @tparam UseExceptions: If false code uses assert() instead of throwing exceptions for write failures
+     */
+    template <bool UseExceptions = true>
+    class AsyncRecordSink {
+      public:
+        /**
+         * Buffer handed out by AcquireBuffer(), valid until it is submitted.
+         */
+        struct RecordBuffer
+        {
+            size_t               Index;
+            std::span<std::byte> Bytes;
+        };
+
+        /**
+         * @param fd: Descriptor records are appended to, starting at its current position. It is not closed.
+         * @param numBuffers: Number of record buffers, also the maximum number of writes in flight.
+         * @param bufferSize: Size of each record buffer.
+         * @param batchSize: Number of submitted records queued before they are handed to the kernel.
+         */
+        AsyncRecordSink(int fd, size_t numBuffers = 8, size_t bufferSize = 64 * 1024, size_t batchSize = 4)
+            : m_Fd(fd)
+            , m_BufferSize(bufferSize)
+            , m_BatchSize(std::max<size_t>(batchSize, 1))
+            , m_Storage(std::max<size_t>(numBuffers, 1) * bufferSize)
+            , m_States(std::max<size_t>(numBuffers, 1))
+            , m_Offset(-1)
+            , m_NumInFlight(0)
+            , m_NumQueued(0)
+            , m_Error(0)
+        {
+            for (size_t i = m_States.size(); i > 0; --i)
+            {
+                m_States[i - 1].pData = m_Storage.data() + (i - 1) * m_BufferSize;
+                m_FreeBuffers.push_back(i - 1);
+            }
+
+#if defined(__unix__) || defined(__APPLE__)
+            m_Offset = ::lseek(fd, 0, SEEK_CUR);
+#endif
+#if defined(SHARED_ASYNC_RECORD_SINK_IO_URING)
+            if (m_Offset >= 0)
+            {
+                setupRing();
+            }
+#endif
+        }
+
+        AsyncRecordSink(const AsyncRecordSink&)            = delete;
+        AsyncRecordSink& operator=(const AsyncRecordSink&) = delete;
+
+        /**
+         * Waits for all writes and moves the file position past the last record. Failures cannot be reported
+         * from here, call Flush() first to handle them.
+         */
+        ~AsyncRecordSink()
+        {
+            try
+            {
+                Flush();
+            }
+            catch (...)
+            {
+            }
+#if defined(SHARED_ASYNC_RECORD_SINK_IO_URING)
+            teardownRing();
+#endif
+        }
+
+        /**
+         * @return true if writes are performed asynchronously through io_uring.
+         */
+        bool IsAsync() const
+        {
+#if defined(SHARED_ASYNC_RECORD_SINK_IO_URING)
+            return m_Ring.Fd >= 0;
+#else
+            return false;
+#endif
+        }
+
+        /**
+         * @return true if io_uring writes use registered buffers.
+         */
+        bool UsesRegisteredBuffers() const
+        {
+#if defined(SHARED_ASYNC_RECORD_SINK_IO_URING)
+            return m_Ring.RegisteredBuffers;
+#else
+            return false;
+#endif
+        }
+
+        size_t GetBufferSize() const { return m_BufferSize; }
+
+        /**
+         * @return Number of writes submitted and not yet completed.
+         */
+        size_t GetInFlightCount() const { return m_NumInFlight; }
+
+        /**
+         * Get a free record buffer, waiting for an in-flight write to complete if none is free.
+         */
+        RecordBuffer AcquireBuffer()
+        {
+            while (m_FreeBuffers.empty() && m_NumInFlight > 0)
+            {
+                reapCompletions(true);
+            }
+            checkError();
+
+            if (m_FreeBuffers.empty())
+            {
+                fail("No record buffer available, acquired buffers must be submitted.");
+                return RecordBuffer{0, std::span<std::byte>()};
+            }
+
+            size_t index = m_FreeBuffers.back();
+            m_FreeBuffers.pop_back();
+            m_States[index].Status = BufferStatus::Acquired;
+
+            return RecordBuffer{index, std::span<std::byte>(m_States[index].pData, m_BufferSize)};
+        }
+
+        /**
+         * Queue the first size bytes of an acquired buffer to be appended to the file.
+         * The buffer must not be touched afterwards, it is recycled once the write completes.
+         */
+        void Submit(const RecordBuffer& buffer, size_t size)
+        {
+            assert(buffer.Index < m_States.size() && size <= m_BufferSize);
+            assert(m_States[buffer.Index].Status == BufferStatus::Acquired);
+
+            BufferState& state = m_States[buffer.Index];
+            state.Offset       = m_Offset;
+            state.Size         = size;
+            state.Written      = 0;
+            if (m_Offset >= 0)
+            {
+                m_Offset += size;
+            }
+
+            if (!IsAsync() || size == 0)
+            {
+                writeSynchronously(buffer.Index);
+                recycle(buffer.Index);
+                checkError();
+                return;
+            }
+
+#if defined(SHARED_ASYNC_RECORD_SINK_IO_URING)
+            state.Status = BufferStatus::InFlight;
+            ++m_NumInFlight;
+            queueWrite(buffer.Index);
+            if (m_NumQueued >= m_BatchSize)
+            {
+                reapCompletions(false);
+            }
+#endif
+        }
+
+        /**
+         * Copy bytes into a record buffer and submit it.
+         * @param bytes: Record, at most GetBufferSize() bytes.
+         */
+        void Write(std::span<const std::byte> bytes)
+        {
+            assert(bytes.size() <= m_BufferSize);
+
+            RecordBuffer buffer = AcquireBuffer();
+            if (!bytes.empty())
+            {
+                std::memcpy(buffer.Bytes.data(), bytes.data(), bytes.size());
+            }
+            Submit(buffer, bytes.size());
+        }
+
+        /**
+         * Submit all queued writes, wait until every write has completed and move the file position past the
+         * last record.
+         */
+        void Flush()
+        {
+            while (m_NumInFlight > 0)
+            {
+                reapCompletions(true);
+            }
+#if defined(__unix__) || defined(__APPLE__)
+            if (m_Offset >= 0)
+            {
+                ::lseek(m_Fd, m_Offset, SEEK_SET);
+            }
+#endif
+            checkError();
+        }
+
+      private:
+        enum class BufferStatus : uint8_t
+        {
+            Free,
+            Acquired,
+            InFlight
+        };
+
+        struct BufferState
+        {
+            std::byte*   pData;
+            off_t        Offset;
+            size_t       Size;
+            size_t       Written;
+            BufferStatus Status;
+        };
+
+        void recycle(size_t index)
+        {
+            m_States[index].Status = BufferStatus::Free;
+            m_FreeBuffers.push_back(index);
+        }
+
+        void fail(const char* message)
+        {
+            if constexpr (UseExceptions)
+            {
+                throw std::runtime_error(message);
+            }
+            else
+            {
+                assert(false && message);
+            }
+        }
+
+        void checkError()
+        {
+            if (m_Error != 0)
+            {
+                m_Error = 0;
+                fail("Failed to write record.");
+            }
+        }
+
+        void writeSynchronously(size_t index)
+        {
+#if defined(__unix__) || defined(__APPLE__)
+            BufferState&     state = m_States[index];
+            const std::byte* pData = state.pData;
+            while (state.Written < state.Size)
+            {
+                const std::byte* pBegin     = pData + state.Written;
+                size_t           remaining  = state.Size - state.Written;
+                ssize_t          numWritten = state.Offset >= 0
+                                                  ? ::pwrite(m_Fd, pBegin, remaining, state.Offset + state.Written)
+                                                  : ::write(m_Fd, pBegin, remaining);
+                if (numWritten < 0 && errno == EINTR)
+                    continue;
+
+                if (numWritten <= 0)
+                {
+                    m_Error = numWritten < 0 ? errno : EIO;
+                    return;
+                }
+                state.Written += numWritten;
+            }
+#else
+            (void)index;
+            m_Error = ENOSYS;
+#endif
+        }
+
+#if defined(SHARED_ASYNC_RECORD_SINK_IO_URING)
+        /**
+         * Submission/completion rings shared with the kernel.
+         */
+        struct Ring
+        {
+            int           Fd                = -1;
+            bool          RegisteredBuffers = false;
+            void*         pSqRing           = nullptr;
+            size_t        SqRingSize        = 0;
+            void*         pCqRing           = nullptr;
+            size_t        CqRingSize        = 0;
+            io_uring_sqe* pSqes             = nullptr;
+            size_t        SqesSize          = 0;
+            unsigned*     pSqTail           = nullptr;
+            unsigned*     pSqMask           = nullptr;
+            unsigned*     pSqArray          = nullptr;
+            unsigned*     pCqHead           = nullptr;
+            unsigned*     pCqTail           = nullptr;
+            unsigned*     pCqMask           = nullptr;
+            io_uring_cqe* pCqes             = nullptr;
+        };
+
+        void setupRing()
+        {
+            io_uring_params params;
+            std::memset(&params, 0, sizeof(params));
+
+            unsigned numEntries = static_cast<unsigned>(m_States.size());
+            int      ringFd     = static_cast<int>(::syscall(__NR_io_uring_setup, numEntries, &params));
+            if (ringFd < 0)
+                return;
+
+            m_Ring.Fd         = ringFd;
+            m_Ring.SqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+            m_Ring.CqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+            if (params.features & IORING_FEAT_SINGLE_MMAP)
+            {
+                m_Ring.SqRingSize = m_Ring.CqRingSize = std::max(m_Ring.SqRingSize, m_Ring.CqRingSize);
+            }
+
+            m_Ring.pSqRing = ::mmap(nullptr, m_Ring.SqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                    ringFd, IORING_OFF_SQ_RING);
+            if (m_Ring.pSqRing == MAP_FAILED)
+            {
+                m_Ring.pSqRing = nullptr;
+                teardownRing();
+                return;
+            }
+
+            if (params.features & IORING_FEAT_SINGLE_MMAP)
+            {
+                m_Ring.pCqRing = m_Ring.pSqRing;
+            }
+            else
+            {
+                m_Ring.pCqRing = ::mmap(nullptr, m_Ring.CqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                        ringFd, IORING_OFF_CQ_RING);
+                if (m_Ring.pCqRing == MAP_FAILED)
+                {
+                    m_Ring.pCqRing = nullptr;
+                    teardownRing();
+                    return;
+                }
+            }
+
+            m_Ring.SqesSize = params.sq_entries * sizeof(io_uring_sqe);
+            void* pSqes     = ::mmap(nullptr, m_Ring.SqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                     ringFd, IORING_OFF_SQES);
+            if (pSqes == MAP_FAILED)
+            {
+                teardownRing();
+                return;
+            }
+            m_Ring.pSqes = static_cast<io_uring_sqe*>(pSqes);
+
+            char* pSq       = static_cast<char*>(m_Ring.pSqRing);
+            char* pCq       = static_cast<char*>(m_Ring.pCqRing);
+            m_Ring.pSqTail  = reinterpret_cast<unsigned*>(pSq + params.sq_off.tail);
+            m_Ring.pSqMask  = reinterpret_cast<unsigned*>(pSq + params.sq_off.ring_mask);
+            m_Ring.pSqArray = reinterpret_cast<unsigned*>(pSq + params.sq_off.array);
+            m_Ring.pCqHead  = reinterpret_cast<unsigned*>(pCq + params.cq_off.head);
+            m_Ring.pCqTail  = reinterpret_cast<unsigned*>(pCq + params.cq_off.tail);
+            m_Ring.pCqMask  = reinterpret_cast<unsigned*>(pCq + params.cq_off.ring_mask);
+            m_Ring.pCqes    = reinterpret_cast<io_uring_cqe*>(pCq + params.cq_off.cqes);
+
+            // Registered buffers skip the per write page pinning, but registration can fail on a low
+            // RLIMIT_MEMLOCK, in which case plain writes are used.
+            std::vector<iovec> iovecs(m_States.size());
+            for (size_t i = 0; i < iovecs.size(); ++i)
+            {
+                iovecs[i] = iovec{m_Storage.data() + i * m_BufferSize, m_BufferSize};
+            }
+            m_Ring.RegisteredBuffers =
+                m_BufferSize > 0 &&
+                ::syscall(__NR_io_uring_register, ringFd, IORING_REGISTER_BUFFERS, iovecs.data(), iovecs.size()) == 0;
+        }
+
+        void teardownRing()
+        {
+            if (m_Ring.pSqes != nullptr)
+            {
+                ::munmap(m_Ring.pSqes, m_Ring.SqesSize);
+            }
+            if (m_Ring.pCqRing != nullptr && m_Ring.pCqRing != m_Ring.pSqRing)
+            {
+                ::munmap(m_Ring.pCqRing, m_Ring.CqRingSize);
+            }
+            if (m_Ring.pSqRing != nullptr)
+            {
+                ::munmap(m_Ring.pSqRing, m_Ring.SqRingSize);
+            }
+            if (m_Ring.Fd >= 0)
+            {
+                ::close(m_Ring.Fd);
+            }
+            m_Ring = Ring();
+        }
+
+        /**
+         * Add a write for the unwritten part of a buffer to the submission queue.
+         * Every buffer has at most one write queued or in flight, so the queue, sized to the number of
+         * buffers, cannot overflow.
+         */
+        void queueWrite(size_t index)
+        {
+            BufferState& state = m_States[index];
+
+            unsigned      tail = *m_Ring.pSqTail;
+            unsigned      slot = tail & *m_Ring.pSqMask;
+            io_uring_sqe& sqe  = m_Ring.pSqes[slot];
+            std::memset(&sqe, 0, sizeof(sqe));
+
+            sqe.opcode    = m_Ring.RegisteredBuffers ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+            sqe.fd        = m_Fd;
+            sqe.addr      = reinterpret_cast<uint64_t>(state.pData + state.Written);
+            sqe.len       = static_cast<uint32_t>(state.Size - state.Written);
+            sqe.off       = static_cast<uint64_t>(state.Offset + state.Written);
+            sqe.buf_index = m_Ring.RegisteredBuffers ? static_cast<uint16_t>(index) : 0;
+            sqe.user_data = index;
+
+            m_Ring.pSqArray[slot] = slot;
+            std::atomic_ref<unsigned>(*m_Ring.pSqTail).store(tail + 1, std::memory_order_release);
+            ++m_NumQueued;
+        }
+
+        /**
+         * Submit queued writes and process completions, recycling finished buffers and resubmitting the rest
+         * of short writes.
+         * @param wait: Block until at least one write completes.
+         */
+        void reapCompletions(bool wait)
+        {
+            unsigned minComplete = wait ? 1 : 0;
+            unsigned flags       = wait ? IORING_ENTER_GETEVENTS : 0;
+            if (m_NumQueued > 0 || wait)
+            {
+                long result = ::syscall(__NR_io_uring_enter, m_Ring.Fd, static_cast<unsigned>(m_NumQueued),
+                                        minComplete, flags, nullptr, 0);
+                if (result >= 0)
+                {
+                    m_NumQueued -= std::min<size_t>(static_cast<size_t>(result), m_NumQueued);
+                }
+                else if (errno != EINTR && errno != EAGAIN && errno != EBUSY)
+                {
+                    abandonRing();
+                    return;
+                }
+            }
+
+            processCompletions();
+        }
+
+        /**
+         * Process the completions posted so far, recycling finished buffers and queueing the rest of short
+         * writes.
+         */
+        void processCompletions()
+        {
+            unsigned head = *m_Ring.pCqHead;
+            unsigned tail = std::atomic_ref<unsigned>(*m_Ring.pCqTail).load(std::memory_order_acquire);
+            for (; head != tail; ++head)
+            {
+                const io_uring_cqe& cqe   = m_Ring.pCqes[head & *m_Ring.pCqMask];
+                size_t              index = static_cast<size_t>(cqe.user_data);
+                BufferState&        state = m_States[index];
+
+                if (cqe.res == -EINTR || cqe.res == -EAGAIN)
+                {
+                    queueWrite(index);
+                    continue;
+                }
+
+                if (cqe.res <= 0)
+                {
+                    m_Error = cqe.res < 0 ? -cqe.res : EIO;
+                }
+                else
+                {
+                    state.Written += cqe.res;
+                    if (state.Written < state.Size)
+                    {
+                        queueWrite(index);
+                        continue;
+                    }
+                }
+
+                recycle(index);
+                --m_NumInFlight;
+            }
+            std::atomic_ref<unsigned>(*m_Ring.pCqHead).store(head, std::memory_order_release);
+        }
+
+        /**
+         * The ring is unusable. Process the completions already posted, tear the ring down and switch to
+         * synchronous writes. Writes still in flight are repeated synchronously at their offsets, a late
+         * kernel write stores the same bytes. The kernel may still read from their buffers, so they get new
+         * storage and the old storage is kept until the sink is destroyed.
+         */
+        void abandonRing()
+        {
+            processCompletions();
+            teardownRing();
+            m_NumQueued = 0;
+
+            for (size_t index = 0; index < m_States.size(); ++index)
+            {
+                if (m_States[index].Status == BufferStatus::InFlight)
+                {
+                    writeSynchronously(index);
+                    m_ReplacedBuffers.emplace_back(m_BufferSize);
+                    m_States[index].pData = m_ReplacedBuffers.back().data();
+                    recycle(index);
+                }
+            }
+            m_NumInFlight = 0;
+        }
+
+        Ring m_Ring;
+#endif
+
+        int                                 m_Fd;
+        size_t                              m_BufferSize;
+        size_t                              m_BatchSize;
+        std::vector<std::byte>              m_Storage;
+        std::vector<BufferState>            m_States;
+        std::vector<size_t>                 m_FreeBuffers;
+        std::vector<std::vector<std::byte>> m_ReplacedBuffers;
+        off_t                               m_Offset;
+        size_t                              m_NumInFlight;
+        size_t                              m_NumQueued;
+        int                                 m_Error;
+    };
+} // namespace Shared
+
+#undef SHARED_ASYNC_RECORD_SINK_IO_URING
@@ -0,0 +1,618 @@
+#pragma once
+
+#include "BinaryWriter.hpp"
+#include "SerializeDeserializeNum.hpp"
+#include "StructSerializer.hpp"
+#include "Varint.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <unistd.h>
+#endif
+
+namespace Shared {
+    /**
+     * Default number of bytes staged by BinaryStreamWriter/BinaryStreamReader between sink/source calls.
+     */
+    constexpr size_t DefaultStreamBufferSize = 64 * 1024;
+
+    /**
+     * Smallest staging buffer, large enough for any single numeric value, length prefix or varint.
+     */
+    constexpr size_t MinStreamBufferSize = 16;
+
+    /**
+     * Binary writer that streams to a sink through a fixed size staging buffer.
+     * Values are serialized into the staging buffer and handed to the sink whenever it fills up, so
+     * arbitrarily large outputs are written with constant memory. The wire format matches BinaryWriter.
+     * The class is not thread safe.
+     * @tparam UseExceptions: If false code uses assert() instead of throwing exceptions for failures
+     * @tparam endianess: Byte order used for numeric values and fixed size array lengths
+     */
+    template <bool UseExceptions = true, Endianess endianess = Endianess::LittleEndian>
+    class BinaryStreamWriter {
+      public:
+        /**
+         * Called with each block of serialized bytes, returns false if the bytes could not be written.
+         */
+        typedef std::function<bool(std::span<const std::byte>)> sinkType;
+
+        /**
+         * @param sink: Destination of the serialized bytes.
+         * @param bufferSize: Number of bytes staged before the sink is called.
+         */
+        BinaryStreamWriter(sinkType sink, size_t bufferSize = DefaultStreamBufferSize)
+            : m_Sink(std::move(sink))
+            , m_Buffer(std::max(bufferSize, MinStreamBufferSize))
+            , m_Size(0)
+            , m_FlushedSize(0)
+        {
+        }
+
+        BinaryStreamWriter(const BinaryStreamWriter&)            = delete;
+        BinaryStreamWriter& operator=(const BinaryStreamWriter&) = delete;
+
+        /**
+         * Flushes staged bytes. Failures cannot be reported from here, call Flush() first to handle them.
+         */
+        ~BinaryStreamWriter()
+        {
+            try
+            {
+                Flush();
+            }
+            catch (...)
+            {
+            }
+        }
+
+        /**
+         * Hand all staged bytes to the sink.
+         */
+        void Flush()
+        {
+            if (m_Size == 0)
+                return;
+
+            size_t size = m_Size;
+            m_Size      = 0;
+            writeToSink(std::span<const std::byte>(m_Buffer.data(), size));
+        }
+
+        /**
+         * @return Number of bytes staged and not yet handed to the sink.
+         */
+        size_t GetBufferedSize() const { return m_Size; }
+
+        /**
+         * @return Total number of bytes written, including staged bytes.
+         */
+        size_t GetSize() const { return m_FlushedSize + m_Size; }
+
+        /**
+         * Write numeric value to the stream.
+         * @tparam T: Type of value to write to the stream.
+         * @param value: Value of T to write to the stream.
+         */
+        template <class T>
+        void WriteNum(T value)
+        {
+            prepareMem(sizeof(T));
+            SerializeArithmaticType<T, endianess>(value, m_Buffer.data() + m_Size);
+            m_Size += sizeof(T);
+        }
+
+        /**
+         * Write an array of numeric values to the stream.
+         * Contiguous input is serialized in bulk, one staging buffer at a time.
+         * @tparam w_INPUT_IT: Iterator/Pointer type for the inputs.
+         * @param begin: Iterator/Pointer to first item in array.
+         * @param end: Iterator/Pointer to last item in array.
+         * @param prefix: Encoding of the element count written before the array.
+         */
+        template <class w_INPUT_IT>
+        void WriteArrayNum(w_INPUT_IT begin, w_INPUT_IT end, LengthPrefix prefix = LengthPrefix::Fixed)
+        {
+            typedef std::remove_cv_t<typename std::iterator_traits<w_INPUT_IT>::value_type> T;
+
+            size_t arraySize = std::distance(begin, end);
+            writeLengthPrefix(arraySize, prefix);
+
+            if constexpr (std::contiguous_iterator<w_INPUT_IT>)
+            {
+                const T* pValues = std::to_address(begin);
+                while (arraySize > 0)
+                {
+                    prepareMem(sizeof(T));
+
+                    size_t count = std::min(arraySize, (m_Buffer.size() - m_Size) / sizeof(T));
+                    SerializeArithmaticArray<T, std::byte, endianess>(pValues, count, m_Buffer.data() + m_Size);
+                    m_Size += count * sizeof(T);
+                    pValues += count;
+                    arraySize -= count;
+                }
+            }
+            else
+            {
+                for (auto it = begin; it != end; ++it)
+                {
+                    WriteNum<T>(*it);
+                }
+            }
+        }
+
+        /**
+         * Write raw bytes to the stream. Blocks larger than the staging buffer go straight to the sink.
+         * @param bytes: Bytes to write to the stream.
+         */
+        void WriteBytes(std::span<const std::byte> bytes)
+        {
+            if (bytes.size() > m_Buffer.size() - m_Size)
+            {
+                Flush();
+                if (bytes.size() >= m_Buffer.size())
+                {
+                    writeToSink(bytes);
+                    return;
+                }
+            }
+
+            if (!bytes.empty())
+            {
+                std::memcpy(m_Buffer.data() + m_Size, bytes.data(), bytes.size());
+                m_Size += bytes.size();
+            }
+        }
+
+        /**
+         * Write integral value to the stream as a LEB128 varint, see BinaryWriter::WriteVarint.
+         */
+        template <class T>
+        void WriteVarint(T value)
+        {
+            writeVarintRaw(ToVarintValue(value));
+        }
+
+        /**
+         * Write a varint element count followed by each value as a varint.
+         */
+        template <class w_INPUT_IT>
+        void WriteVarintArray(w_INPUT_IT begin, w_INPUT_IT end)
+        {
+            writeVarintRaw(std::distance(begin, end));
+            for (auto it = begin; it != end; ++it)
+            {
+                writeVarintRaw(ToVarintValue(*it));
+            }
+        }
+
+        /**
+         * Write a struct described by StructFields to the stream, see StructSerializer.hpp.
+         */
+        template <class T>
+        void WriteStruct(const T& value)
+        {
+            if constexpr (StructWireSize<T> <= MinStreamBufferSize)
+            {
+                prepareMem(StructWireSize<T>);
+                SerializeStruct<T, endianess>(value, m_Buffer.data() + m_Size);
+                m_Size += StructWireSize<T>;
+            }
+            else
+            {
+                std::array<std::byte, StructWireSize<T>> bytes;
+                SerializeStruct<T, endianess>(value, bytes.data());
+                WriteBytes(bytes);
+            }
+        }
+
+      private:
+        /**
+         * Flush if fewer than size bytes are free in the staging buffer.
+         */
+        void prepareMem(size_t size)
+        {
+            if (m_Buffer.size() - m_Size < size)
+            {
+                Flush();
+            }
+        }
+
+        void writeToSink(std::span<const std::byte> bytes)
+        {
+            if (!m_Sink(bytes))
+            {
+                if constexpr (UseExceptions)
+                {
+                    throw std::runtime_error("Failed to write to stream sink.");
+                }
+                else
+                {
+                    assert(false && "Failed to write to stream sink.");
+                }
+            }
+            m_FlushedSize += bytes.size();
+        }
+
+        void writeLengthPrefix(size_t arraySize, LengthPrefix prefix)
+        {
+            if (prefix == LengthPrefix::Varint)
+            {
+                writeVarintRaw(arraySize);
+            }
+            else
+            {
+                WriteNum<size_t>(arraySize);
+            }
+        }
+
+        void writeVarintRaw(uint64_t rawValue)
+        {
+            prepareMem(MaxVarintSize<uint64_t>);
+            m_Size += EncodeVarint(rawValue, m_Buffer.data() + m_Size);
+        }
+
+        sinkType               m_Sink;
+        std::vector<std::byte> m_Buffer;
+        size_t                 m_Size;
+        size_t                 m_FlushedSize;
+    };
+
+    /**
+     * Binary reader that streams from a source through a fixed size staging buffer.
+     * The staging buffer is refilled from the source whenever a read needs more bytes than it holds, so
+     * arbitrarily large inputs are read with constant memory. The wire format matches BinaryWriter.
+     * The class is not thread safe.
+     * @tparam UseExceptions: If false code uses assert() instead of throwing exceptions for failures
+     * @tparam endianess: Byte order used for numeric values and fixed size array lengths
+     */
+    template <bool UseExceptions = true, Endianess endianess = Endianess::LittleEndian>
+    class BinaryStreamReader {
+      public:
+        /**
+         * Called to fill the given bytes, returns the number of bytes read, 0 at the end of the stream or a
+         * negative value on failure.
+         */
+        typedef std::function<std::ptrdiff_t(std::span<std::byte>)> sourceType;
+
+        /**
+         * @param source: Origin of the serialized bytes.
+         * @param bufferSize: Number of bytes requested from the source at a time.
+         */
+        BinaryStreamReader(sourceType source, size_t bufferSize = DefaultStreamBufferSize)
+            : m_Source(std::move(source))
+            , m_Buffer(std::max(bufferSize, MinStreamBufferSize))
+            , m_ReadLoc(0)
+            , m_Size(0)
+            , m_ConsumedSize(0)
+            , m_EndOfStream(false)
+        {
+        }
+
+        BinaryStreamReader(const BinaryStreamReader&)            = delete;
+        BinaryStreamReader& operator=(const BinaryStreamReader&) = delete;
+
+        /**
+         * @return true if all bytes of the source have been read.
+         */
+        bool AtEnd() { return !fill(1); }
+
+        /**
+         * @return Total number of bytes read from the stream.
+         */
+        size_t GetPosition() const { return m_ConsumedSize + m_ReadLoc; }
+
+        /**
+         * Read numeric value from the stream.
+         * @tparam T: Type of numeric value to read from the stream.
+         * @return Value of type T read from the stream.
+         */
+        template <class T>
+        T ReadNum()
+        {
+            canRead(sizeof(T));
+
+            T value = DeSerializeArithmaticType<T, endianess>(m_Buffer.data() + m_ReadLoc);
+            m_ReadLoc += sizeof(T);
+
+            return value;
+        }
+
+        /**
+         * Read an array of numeric values from the stream, one staging buffer at a time.
+         * @tparam T: Type of the numeric value to read into array.
+         * @param prefix: Encoding of the element count written before the array.
+         * @return Vector of T values read from the stream.
+         */
+        template <class T>
+        std::vector<T> ReadArrayNum(LengthPrefix prefix = LengthPrefix::Fixed)
+        {
+            size_t arraySize = prefix == LengthPrefix::Varint ? readVarintRaw() : ReadNum<size_t>();
+
+            // Grow with the data actually read so a corrupt length cannot trigger a huge allocation.
+            std::vector<T> returnVal;
+            while (returnVal.size() < arraySize)
+            {
+                canRead(sizeof(T));
+
+                size_t count  = std::min(arraySize - returnVal.size(), (m_Size - m_ReadLoc) / sizeof(T));
+                size_t offset = returnVal.size();
+                returnVal.resize(offset + count);
+                DeSerializeArithmaticArray<T, std::byte, endianess>(
+                    m_Buffer.data() + m_ReadLoc,
+                    count,
+                    returnVal.data() + offset);
+                m_ReadLoc += count * sizeof(T);
+            }
+
+            return returnVal;
+        }
+
+        /**
+         * Read raw bytes from the stream. Large blocks are read from the source straight into bytes.
+         * @param bytes: Filled with bytes read from the stream.
+         */
+        void ReadBytes(std::span<std::byte> bytes)
+        {
+            size_t count = std::min(bytes.size(), m_Size - m_ReadLoc);
+            if (count > 0)
+            {
+                std::memcpy(bytes.data(), m_Buffer.data() + m_ReadLoc, count);
+                m_ReadLoc += count;
+            }
+            bytes = bytes.subspan(count);
+
+            if (bytes.size() >= m_Buffer.size())
+            {
+                while (!bytes.empty())
+                {
+                    std::ptrdiff_t numRead = readFromSource(bytes);
+                    if (numRead == 0)
+                    {
+                        endOfStream();
+                        return;
+                    }
+                    m_ConsumedSize += numRead;
+                    bytes = bytes.subspan(numRead);
+                }
+            }
+            else if (!bytes.empty())
+            {
+                canRead(bytes.size());
+                std::memcpy(bytes.data(), m_Buffer.data() + m_ReadLoc, bytes.size());
+                m_ReadLoc += bytes.size();
+            }
+        }
+
+        /**
+         * Read integral value stored as a LEB128 varint, see BinaryWriter::ReadVarint.
+         */
+        template <class T>
+        T ReadVarint()
+        {
+            T value{0};
+            if (!FromVarintValue(readVarintRaw(), value))
+            {
+                invalidVarint();
+            }
+
+            return value;
+        }
+
+        /**
+         * Read an array written by WriteVarintArray.
+         */
+        template <class T>
+        std::vector<T> ReadVarintArray()
+        {
+            size_t arraySize = readVarintRaw();
+
+            std::vector<T> returnVal;
+            for (size_t i = 0; i < arraySize; ++i)
+            {
+                returnVal.push_back(ReadVarint<T>());
+            }
+
+            return returnVal;
+        }
+
+        /**
+         * Read a struct described by StructFields from the stream.
+         */
+        template <class T>
+        void ReadStruct(T& value)
+        {
+            if constexpr (StructWireSize<T> <= MinStreamBufferSize)
+            {
+                canRead(StructWireSize<T>);
+                DeSerializeStruct<T, endianess>(m_Buffer.data() + m_ReadLoc, value);
+                m_ReadLoc += StructWireSize<T>;
+            }
+            else
+            {
+                std::array<std::byte, StructWireSize<T>> bytes;
+                ReadBytes(bytes);
+                DeSerializeStruct<T, endianess>(bytes.data(), value);
+            }
+        }
+
+        template <class T>
+        T ReadStruct()
+        {
+            T value{};
+            ReadStruct(value);
+
+            return value;
+        }
+
+      private:
+        /**
+         * Refill the staging buffer until at least size unread bytes are available or the source ends.
+         * @return true if size bytes are available.
+         */
+        bool fill(size_t size)
+        {
+            assert(size <= m_Buffer.size());
+
+            if (m_Size - m_ReadLoc >= size)
+                return true;
+
+            if (m_Buffer.size() - m_ReadLoc < size)
+            {
+                // Move the unread tail to the front to make room.
+                std::memmove(m_Buffer.data(), m_Buffer.data() + m_ReadLoc, m_Size - m_ReadLoc);
+                m_ConsumedSize += m_ReadLoc;
+                m_Size -= m_ReadLoc;
+                m_ReadLoc = 0;
+            }
+
+            while (m_Size - m_ReadLoc < size && !m_EndOfStream)
+            {
+                std::ptrdiff_t numRead =
+                    readFromSource(std::span<std::byte>(m_Buffer.data() + m_Size, m_Buffer.size() - m_Size));
+                m_Size += numRead;
+            }
+
+            return m_Size - m_ReadLoc >= size;
+        }
+
+        std::ptrdiff_t readFromSource(std::span<std::byte> bytes)
+        {
+            if (m_EndOfStream)
+                return 0;
+
+            std::ptrdiff_t numRead = m_Source(bytes);
+            if (numRead < 0)
+            {
+                m_EndOfStream = true;
+                if constexpr (UseExceptions)
+                {
+                    throw std::runtime_error("Failed to read from stream source.");
+                }
+                else
+                {
+                    assert(false && "Failed to read from stream source.");
+                    return 0;
+                }
+            }
+            if (numRead == 0)
+            {
+                m_EndOfStream = true;
+            }
+
+            return numRead;
+        }
+
+        void canRead(size_t size)
+        {
+            if (!fill(size))
+            {
+                endOfStream();
+            }
+        }
+
+        void endOfStream()
+        {
+            if constexpr (UseExceptions)
+            {
+                throw std::runtime_error("Unexpected end of stream.");
+            }
+            else
+            {
+                assert(false && "Unexpected end of stream.");
+            }
+        }
+
+        void invalidVarint()
+        {
+            if constexpr (UseExceptions)
+            {
+                throw std::runtime_error("Invalid or truncated varint.");
+            }
+            else
+            {
+                assert(false && "Invalid or truncated varint.");
+            }
+        }
+
+        uint64_t readVarintRaw()
+        {
+            // A varint can end before MaxVarintSize bytes, so only fail if nothing at all is left.
+            fill(MaxVarintSize<uint64_t>);
+            canRead(1);
+
+            uint64_t rawValue{0};
+            size_t   numBytes = DecodeVarint(m_Buffer.data() + m_ReadLoc, m_Buffer.data() + m_Size, rawValue);
+            if (numBytes == 0)
+            {
+                invalidVarint();
+                return 0;
+            }
+            m_ReadLoc += numBytes;
+
+            return rawValue;
+        }
+
+        sourceType             m_Source;
+        std::vector<std::byte> m_Buffer;
+        size_t                 m_ReadLoc;
+        size_t                 m_Size;
+        size_t                 m_ConsumedSize;
+        bool                   m_EndOfStream;
+    };
+
+#if defined(__unix__) || defined(__APPLE__)
+    /**
+     * Sink writing to a file descriptor, partial writes and interrupted calls are retried.
+     * The descriptor is not closed.
+     */
+    inline std::function<bool(std::span<const std::byte>)> FileDescriptorSink(int fd)
+    {
+        return [fd](std::span<const std::byte> bytes) {
+            while (!bytes.empty())
+            {
+                ssize_t numWritten = ::write(fd, bytes.data(), bytes.size());
+                if (numWritten < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+
+                    return false;
+                }
+                bytes = bytes.subspan(numWritten);
+            }
+
+            return true;
+        };
+    }
+
+    /**
+     * Source reading from a file descriptor, interrupted calls are retried.
+     * The descriptor is not closed.
+     */
+    inline std::function<std::ptrdiff_t(std::span<std::byte>)> FileDescriptorSource(int fd)
+    {
+        return [fd](std::span<std::byte> bytes) -> std::ptrdiff_t {
+            while (true)
+            {
+                ssize_t numRead = ::read(fd, bytes.data(), bytes.size());
+                if (numRead >= 0 || errno != EINTR)
+                    return numRead;
+            }
+        };
+    }
+#endif
+} // namespace Shared
@@ -1,11 +1,34 @@
+#pragma once
+
+#include "ArithmaticArrayView.hpp"
+#include "BoundsPolicy.hpp"
+#include "MessageView.hpp"
 #include "SerializeDeserializeNum.hpp"
+#include "StructSerializer.hpp"
+#include "Varint.hpp"
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <cstddef>
+#include <cstring>
+#include <iterator>
 #include <memory>
+#include <memory_resource>
+#include <span>
+#include <type_traits>
 #include <vector>
 
 namespace Shared {
+    /**
+     * Encoding used for the element count written in front of arrays.
+     */
+    enum class LengthPrefix
+    {
+        Fixed,  ///< sizeof(size_t) bytes
+        Varint, ///< LEB128 varint, 1 byte for arrays shorter than 128 elements
+    };
+
     /**
      * Binary Writer class for conveniantly reading/writing data to a buffer.
      * The user can supply a buffer or the class can manage it for the user.
@@ -13,21 +36,38 @@ namespace Shared {
      * The class is not thread safe. Do not try to read/write from multiple threads.
      * @tparam INPUT_IT: Iterator/pointer type for the underlying buffer
      * @tparam UseExceptions: If true code uses assert() instead of throwing exceptions for invalid operations
+     * @tparam endianess: Byte order used for numeric values and fixed size array lengths
+     * @tparam BoundsPolicy: Policy applied when a read/write would leave the buffer, see BoundsPolicy.hpp.
+     * Defaults to throwing or asserting based on UseExceptions.
+     * @tparam Allocator: Allocator for a managed buffer. With std::pmr::polymorphic_allocator the buffer can
+     * come from an arena or a BufferPool, see pmr::BinaryWriter.
      */
-    template <class INPUT_IT = std::vector<unsigned char>::iterator, bool UseExceptions = true>
+    template <
+        class INPUT_IT = std::vector<unsigned char>::iterator,
+        bool UseExceptions = true,
+        Endianess endianess = Endianess::LittleEndian,
+        class BoundsPolicy = DefaultBoundsPolicy<UseExceptions>,
+        class Allocator = std::allocator<unsigned char>>
     class BinaryWriter {
+        typedef typename std::iterator_traits<INPUT_IT>::value_type byteType;
+        typedef std::vector<unsigned char, Allocator>               bufferType;
+
       public:
         /**
          * Construct class and have class manage buffer.
-         * @param initialSize: Specific size to initialize buffer to.
+         * @param initialCapacity: Number of bytes to reserve up front, the buffer still starts empty.
+         * @param allocator: Allocator for the managed buffer.
          */
-        BinaryWriter(size_t initialSize = 0)
+        BinaryWriter(size_t initialCapacity = 0, const Allocator& allocator = Allocator())
             : m_UseExternalMem(false)
-            , m_MemBuffer(initialSize, 0x00)
-            , m_Begin(m_MemBuffer.begin())
-            , m_End(m_MemBuffer.end())
+            , m_MemBuffer(initialCapacity, 0x00, allocator)
+            , m_Begin(managedBegin())
+            , m_End(m_Begin)
             , m_CurrentLoc(m_Begin)
         {
+            static_assert(
+                std::is_pointer<INPUT_IT>::value || std::is_convertible<typename bufferType::iterator, INPUT_IT>::value,
+                "Managed buffers require INPUT_IT to be a pointer or the managed vector's iterator.");
         }
         /**
          * Construct class and have it write data to external buffer.
@@ -57,9 +97,7 @@ namespace Shared {
             }
             else
             {
-                m_MemBuffer.resize(0);
-                m_Begin      = m_MemBuffer.begin();
-                m_End        = m_MemBuffer.end();
+                m_End        = m_Begin;
                 m_CurrentLoc = m_Begin;
             }
         }
@@ -81,8 +119,48 @@ namespace Shared {
                     assert(loc <= totalSize);
                 }
             }
+
+            m_CurrentLoc = m_Begin + loc;
+        }
+
+        /**
+         * Ensure the buffer can hold at least capacity bytes without reallocating.
+         * Only buffers managed by the class can grow.
+         * @param capacity: Total number of bytes the buffer must be able to hold.
+         */
+        void Reserve(size_t capacity)
+        {
+            if (capacity <= Capacity())
+                return;
+
+            if constexpr (UseExceptions)
+            {
+                if (m_UseExternalMem)
+                {
+                    throw std::invalid_argument("Cannot reserve past end of external storage.");
+                }
+            }
+            else
+            {
+                assert(!m_UseExternalMem);
+            }
+
+            reallocate(capacity);
         }
 
+        /**
+         * @return Number of bytes the buffer can hold without reallocating.
+         */
+        size_t Capacity() const
+        {
+            return m_UseExternalMem ? std::distance(m_Begin, m_End) : m_MemBuffer.size();
+        }
+
+        /**
+         * @return Allocator of the managed buffer.
+         */
+        Allocator GetAllocator() const { return m_MemBuffer.get_allocator(); }
+
         /**
          * @return Iterator/Pointer to beginning of the buffer.
          */
@@ -94,61 +172,113 @@ namespace Shared {
         INPUT_IT GetCurLoc() const { return m_CurrentLoc; }
 
         /**
-         * @return Iterator/Pointer to end location of the buffer.
+         * @return Iterator/Pointer to end location of the buffer. For a managed buffer this is the end of the
+         * written data.
          */
         INPUT_IT GetEnd() const { return m_End; }
 
         /**
-         * @return Current buffer size.
+         * @return Number of bytes written for a managed buffer, size of the buffer for external storage.
          */
         size_t GetSize() const { return std::distance(m_Begin, m_End); }
 
         /**
          * Write an array of numeric values to the buffer.
+         * Contiguous input is copied in bulk, see SerializeArithmaticArray.
          * @tparam w_INPUT_IT: Iterator/Pointer type for the inputs.
          * @param begin: Iterator/Pointer to first item in array.
          * @param end: Iterator/Pointer to last item in array.
+         * @param prefix: Encoding of the element count written before the array.
          */
         template <class w_INPUT_IT>
-        void WriteArrayNum(w_INPUT_IT begin, w_INPUT_IT end)
+        void WriteArrayNum(w_INPUT_IT begin, w_INPUT_IT end, LengthPrefix prefix = LengthPrefix::Fixed)
         {
+            typedef std::remove_cv_t<typename std::iterator_traits<w_INPUT_IT>::value_type> T;
+
             size_t arraySize = std::distance(begin, end);
-            size_t totalSize{sizeof(size_t) + arraySize * sizeof(*begin)};
+            size_t totalSize{GetArrayNumSize<T>(arraySize, prefix)};
 
             prepareMem(totalSize);
-
-            SerializeArithmaticType(arraySize, m_CurrentLoc, m_CurrentLoc + sizeof(arraySize));
-            m_CurrentLoc += sizeof(arraySize);
-
-            for (auto it = begin; it != end; ++it)
-            {
-                SerializeArithmaticType(*begin, m_CurrentLoc, m_CurrentLoc + sizeof(*begin));
-                m_CurrentLoc += sizeof(*begin);
-            }
+            writeArrayNumUnchecked(begin, end, arraySize, prefix);
         }
 
         /**
          * Read an array of numeric values from the buffer.
          * @tparam T: Type of the numeric value to read into array.
+         * @param prefix: Encoding of the element count written before the array.
          * @return Vector of T values read from buffer.
          */
         template <class T>
-        std::vector<T> ReadArrayNum()
+        std::vector<T> ReadArrayNum(LengthPrefix prefix = LengthPrefix::Fixed)
         {
-            canRead(sizeof(size_t));
-            size_t arraySize = ReadNum<size_t>();
+            size_t arraySize = readLengthPrefix(prefix);
             size_t totalSize{arraySize * sizeof(T)};
 
             canRead(totalSize);
 
             std::vector<T> returnVal(arraySize, 0);
-            for (size_t i = 0; i < arraySize; ++i)
+            if constexpr (std::contiguous_iterator<INPUT_IT>)
             {
-                returnVal.at(i) = DeSerializeArithmaticType<T>(m_CurrentLoc, m_CurrentLoc + sizeof(T));
-                m_CurrentLoc += sizeof(T);
+                if (arraySize > 0)
+                {
+                    DeSerializeArithmaticArray<T, byteType, endianess>(
+                        std::to_address(m_CurrentLoc),
+                        arraySize,
+                        returnVal.data());
+                    m_CurrentLoc += totalSize;
+                }
             }
+            else
+            {
+                for (T& value : returnVal)
+                {
+                    value = readNumUnchecked<T>();
+                }
+            }
+
+            return returnVal;
+        }
+
+        /**
+         * Read an array of numeric values without copying it out of the buffer.
+         * The returned view decodes values lazily and is only valid while the buffer is.
+         * @tparam T: Type of the numeric values in the array.
+         * @param prefix: Encoding of the element count written before the array.
+         * @return View over the array values read from buffer.
+         */
+        template <class T>
+        ArithmaticArrayView<T, endianess> ReadArrayView(LengthPrefix prefix = LengthPrefix::Fixed)
+        {
+            size_t arraySize = readLengthPrefix(prefix);
+
+            return ArithmaticArrayView<T, endianess>(ReadBytes(arraySize * sizeof(T)));
+        }
+
+        /**
+         * Write raw bytes to the buffer.
+         * @param bytes: Bytes to copy into the buffer.
+         */
+        void WriteBytes(std::span<const std::byte> bytes)
+        {
+            prepareMem(bytes.size());
+            writeBytesUnchecked(bytes);
+        }
+
+        /**
+         * Read raw bytes without copying them out of the buffer.
+         * The returned span is only valid while the buffer is.
+         * @param count: Number of bytes to read.
+         * @return View over the bytes read from buffer.
+         */
+        std::span<const std::byte> ReadBytes(size_t count)
+        {
+            static_assert(std::contiguous_iterator<INPUT_IT>, "INPUT_IT must be contiguous to create views.");
 
-            return std::move(returnVal);
+            canRead(count);
+            std::span<const std::byte> bytes(reinterpret_cast<const std::byte*>(std::to_address(m_CurrentLoc)), count);
+            m_CurrentLoc += count;
+
+            return bytes;
         }
 
         /**
@@ -160,8 +290,7 @@ namespace Shared {
         void WriteNum(T value)
         {
             prepareMem(sizeof(T));
-            SerializeArithmaticType(value, m_CurrentLoc, m_CurrentLoc + sizeof(T));
-            m_CurrentLoc += sizeof(T);
+            writeNumUnchecked(value);
         }
 
         /**
@@ -173,30 +302,306 @@ namespace Shared {
         T ReadNum()
         {
             canRead(sizeof(T));
-            T value = DeSerializeArithmaticType<T>(m_CurrentLoc, m_CurrentLoc + sizeof(T));
-            m_CurrentLoc += sizeof(T);
+
+            return readNumUnchecked<T>();
+        }
+
+        /**
+         * Write a struct described by StructFields to the buffer, see StructSerializer.hpp.
+         * The packed size is known at compile time so the whole struct costs a single bounds check.
+         * @tparam T: Type of struct to write to the buffer.
+         * @param value: Struct to write to the buffer.
+         */
+        template <class T>
+        void WriteStruct(const T& value)
+        {
+            prepareMem(StructWireSize<T>);
+            if constexpr (std::contiguous_iterator<INPUT_IT>)
+            {
+                SerializeStruct<T, endianess>(value, std::to_address(m_CurrentLoc));
+                m_CurrentLoc += StructWireSize<T>;
+            }
+            else
+            {
+                std::array<std::byte, StructWireSize<T>> bytes;
+                SerializeStruct<T, endianess>(value, bytes.data());
+                writeBytesUnchecked(bytes);
+            }
+        }
+
+        /**
+         * Read a struct described by StructFields from the buffer.
+         * @tparam T: Type of struct to read from the buffer.
+         * @param value: Set to the struct read from the buffer.
+         */
+        template <class T>
+        void ReadStruct(T& value)
+        {
+            canRead(StructWireSize<T>);
+            if constexpr (std::contiguous_iterator<INPUT_IT>)
+            {
+                DeSerializeStruct<T, endianess>(std::to_address(m_CurrentLoc), value);
+                m_CurrentLoc += StructWireSize<T>;
+            }
+            else
+            {
+                std::array<std::byte, StructWireSize<T>> bytes;
+                for (std::byte& byte : bytes)
+                {
+                    byte = static_cast<std::byte>(*m_CurrentLoc);
+                    ++m_CurrentLoc;
+                }
+                DeSerializeStruct<T, endianess>(bytes.data(), value);
+            }
+        }
+
+        /**
+         * Read a default constructible struct described by StructFields from the buffer.
+         * @tparam T: Type of struct to read from the buffer.
+         * @return Struct read from the buffer.
+         */
+        template <class T>
+        T ReadStruct()
+        {
+            T value{};
+            ReadStruct(value);
+
+            return value;
+        }
+
+        /**
+         * Read a struct described by StructFields without decoding it.
+         * The returned view decodes fields on access and is only valid while the buffer is.
+         * @tparam T: Type of struct to read from the buffer.
+         * @return View over the serialized struct.
+         */
+        template <class T>
+        MessageView<T, endianess> ReadMessageView()
+        {
+            return MessageView<T, endianess>(ReadBytes(StructWireSize<T>));
+        }
+
+        /**
+         * Write integral value to the buffer as a LEB128 varint.
+         * Signed values are ZigZag encoded so small negative values stay small.
+         * @tparam T: Type of value to write to the buffer.
+         * @param value: Value of T to write to the buffer.
+         */
+        template <class T>
+        void WriteVarint(T value)
+        {
+            uint64_t rawValue = ToVarintValue(value);
+
+            prepareMem(VarintSize(rawValue));
+            writeVarintUnchecked(rawValue);
+        }
+
+        /**
+         * Read LEB128 varint from buffer.
+         * @tparam T: Type of integral value to read from buffer.
+         * @return Value of type T read from buffer.
+         */
+        template <class T>
+        T ReadVarint()
+        {
+            T value{0};
+            if (!FromVarintValue(readVarintRaw(), value))
+            {
+                invalidVarint();
+            }
 
             return value;
         }
 
+        /**
+         * Write an array of integral values to the buffer as varints, with a varint element count.
+         * @tparam w_INPUT_IT: Iterator/Pointer type for the inputs.
+         * @param begin: Iterator/Pointer to first item in array.
+         * @param end: Iterator/Pointer to last item in array.
+         */
+        template <class w_INPUT_IT>
+        void WriteVarintArray(w_INPUT_IT begin, w_INPUT_IT end)
+        {
+            size_t arraySize = std::distance(begin, end);
+            size_t totalSize = VarintSize(arraySize);
+            for (auto it = begin; it != end; ++it)
+            {
+                totalSize += VarintSize(ToVarintValue(*it));
+            }
+
+            prepareMem(totalSize);
+            writeVarintUnchecked(arraySize);
+            for (auto it = begin; it != end; ++it)
+            {
+                writeVarintUnchecked(ToVarintValue(*it));
+            }
+        }
+
+        /**
+         * Read an array of varints written with WriteVarintArray.
+         * @tparam T: Type of the integral values to read into array.
+         * @return Vector of T values read from buffer.
+         */
+        template <class T>
+        std::vector<T> ReadVarintArray()
+        {
+            size_t arraySize = readVarintRaw();
+            // Every varint takes at least one byte, reject sizes the remaining buffer cannot hold.
+            canRead(arraySize);
+
+            std::vector<T> returnVal(arraySize, 0);
+            if constexpr (std::contiguous_iterator<INPUT_IT>)
+            {
+                auto pBegin = std::to_address(m_CurrentLoc);
+                auto pEnd   = pBegin + std::distance(m_CurrentLoc, m_End);
+                auto pLast  = DecodeVarintArray(pBegin, pEnd, returnVal.data(), arraySize);
+                if (pLast == nullptr)
+                {
+                    invalidVarint();
+                    return returnVal;
+                }
+                m_CurrentLoc += pLast - pBegin;
+            }
+            else
+            {
+                for (T& value : returnVal)
+                {
+                    value = ReadVarint<T>();
+                }
+            }
+
+            return returnVal;
+        }
+
+        /**
+         * @tparam T: Type of the numeric values in the array.
+         * @param count: Number of values in the array.
+         * @param prefix: Encoding of the element count written before the array.
+         * @return Number of bytes WriteArrayNum writes for the array.
+         */
+        template <class T>
+        static size_t GetArrayNumSize(size_t count, LengthPrefix prefix = LengthPrefix::Fixed)
+        {
+            return lengthPrefixSize(count, prefix) + count * sizeof(T);
+        }
+
+        /**
+         * Block of buffer space prepared up front by BeginWrite.
+         * Writes through the transaction skip the per-write bounds check, they are only validated with
+         * assert(). The whole block counts as written once the transaction is created.
+         */
+        class WriteTransaction {
+          public:
+            template <class T>
+            void WriteNum(T value)
+            {
+                assert(Remaining() >= sizeof(T));
+                m_Writer.writeNumUnchecked(value);
+            }
+
+            template <class w_INPUT_IT>
+            void WriteArrayNum(w_INPUT_IT begin, w_INPUT_IT end, LengthPrefix prefix = LengthPrefix::Fixed)
+            {
+                typedef std::remove_cv_t<typename std::iterator_traits<w_INPUT_IT>::value_type> T [[maybe_unused]];
+
+                size_t arraySize = std::distance(begin, end);
+                assert(Remaining() >= GetArrayNumSize<T>(arraySize, prefix));
+                m_Writer.writeArrayNumUnchecked(begin, end, arraySize, prefix);
+            }
+
+            void WriteBytes(std::span<const std::byte> bytes)
+            {
+                assert(Remaining() >= bytes.size());
+                m_Writer.writeBytesUnchecked(bytes);
+            }
+
+            /**
+             * @return Number of bytes left in the prepared block.
+             */
+            size_t Remaining() const { return std::distance(m_Writer.m_CurrentLoc, m_BlockEnd); }
+
+          private:
+            friend class BinaryWriter;
+
+            WriteTransaction(BinaryWriter& writer, size_t size)
+                : m_Writer(writer)
+                , m_BlockEnd(writer.m_CurrentLoc + size)
+            {
+            }
+
+            BinaryWriter& m_Writer;
+            INPUT_IT      m_BlockEnd;
+        };
+
+        /**
+         * Block of buffer data validated up front by BeginRead.
+         * Reads through the transaction skip the per-read bounds check, they are only validated with assert().
+         */
+        class ReadTransaction {
+          public:
+            template <class T>
+            T ReadNum()
+            {
+                assert(Remaining() >= sizeof(T));
+                return m_Writer.template readNumUnchecked<T>();
+            }
+
+            /**
+             * @return Number of bytes left in the validated block.
+             */
+            size_t Remaining() const { return std::distance(m_Writer.m_CurrentLoc, m_BlockEnd); }
+
+          private:
+            friend class BinaryWriter;
+
+            ReadTransaction(BinaryWriter& writer, size_t size)
+                : m_Writer(writer)
+                , m_BlockEnd(writer.m_CurrentLoc + size)
+            {
+            }
+
+            BinaryWriter& m_Writer;
+            INPUT_IT      m_BlockEnd;
+        };
+
+        /**
+         * Prepare size bytes at the current location with a single bounds check, then fill them through
+         * the returned transaction. The writer must not be used directly while the transaction is in use.
+         * @param size: Number of bytes that will be written through the transaction.
+         * @return Transaction writing into the prepared block.
+         */
+        WriteTransaction BeginWrite(size_t size)
+        {
+            prepareMem(size);
+            return WriteTransaction(*this, size);
+        }
+
+        /**
+         * Validate size bytes at the current location with a single bounds check, then read them through
+         * the returned transaction. The writer must not be used directly while the transaction is in use.
+         * @param size: Number of bytes that will be read through the transaction.
+         * @return Transaction reading from the validated block.
+         */
+        ReadTransaction BeginRead(size_t size)
+        {
+            canRead(size);
+            return ReadTransaction(*this, size);
+        }
+
       protected:
         /**
          * Validate that a value of a given size can be read from the buffer.
          * Throw or assert if not possible.
          * @param size: Size of value to read from buffer and validate.
          */
-        virtual void canRead(size_t size)
+        void canRead(size_t size)
         {
-            size_t availableSize = std::distance(m_CurrentLoc, m_End);
-            if (availableSize < size)
+            if constexpr (BoundsPolicy::CheckBounds)
             {
-                if constexpr (UseExceptions)
+                size_t availableSize = std::distance(m_CurrentLoc, m_End);
+                if (availableSize < size)
                 {
-                    throw std::runtime_error("Insufficient space to write value.");
-                }
-                else
-                {
-                    assert(availableSize >= size);
+                    BoundsPolicy::OutOfBounds("Insufficient space to write value.");
                 }
             }
         }
@@ -204,55 +609,275 @@ namespace Shared {
         /**
          * Prepare memory buffer for writing. If the class owns
          * the buffer resize appropriately so that insert will succeed.
+         * With UncheckedBounds the capacity is not checked and a managed buffer never grows.
          * @param size: Size of data to be prepared for insertion.
          */
-        virtual void prepareMem(size_t size)
+        void prepareMem(size_t size)
         {
-            size_t availableSize = std::distance(m_CurrentLoc, m_End);
-            if (availableSize < size)
+            if (m_UseExternalMem)
             {
-                auto f_resizeVec = [&]() {
-                    size_t loc = std::distance(m_Begin, m_CurrentLoc);
+                if constexpr (BoundsPolicy::CheckBounds)
+                {
+                    size_t availableSize = std::distance(m_CurrentLoc, m_End);
+                    if (availableSize < size)
+                    {
+                        BoundsPolicy::OutOfBounds("Insufficient space to write value.");
+                    }
+                }
 
-                    size_t resizeLen = (size - availableSize) + m_MemBuffer.size();
-                    m_MemBuffer.resize(resizeLen);
+                return;
+            }
 
-                    m_Begin      = m_MemBuffer.begin();
-                    m_End        = m_MemBuffer.end();
-                    m_CurrentLoc = m_Begin + loc;
-                };
+            size_t loc = std::distance(m_Begin, m_CurrentLoc);
+            if (BoundsPolicy::CheckBounds && m_MemBuffer.size() - loc < size)
+            {
+                // Grow geometrically so a sequence of writes costs amortized O(1) per byte.
+                reallocate(std::max(loc + size, m_MemBuffer.size() * 2));
+            }
 
-                if constexpr (UseExceptions)
+            if (static_cast<size_t>(std::distance(m_CurrentLoc, m_End)) < size)
+            {
+                m_End = m_CurrentLoc + size;
+            }
+        }
+
+      private:
+        /**
+         * Write array length and values at the current location, memory must already be prepared.
+         */
+        template <class w_INPUT_IT>
+        void writeArrayNumUnchecked(w_INPUT_IT begin, w_INPUT_IT end, size_t arraySize, LengthPrefix prefix)
+        {
+            typedef std::remove_cv_t<typename std::iterator_traits<w_INPUT_IT>::value_type> T;
+
+            writeLengthPrefix(arraySize, prefix);
+
+            if constexpr (std::contiguous_iterator<w_INPUT_IT> && std::contiguous_iterator<INPUT_IT>)
+            {
+                if (arraySize > 0)
                 {
-                    if (m_UseExternalMem)
-                    {
-                        throw std::runtime_error("Insufficient space to write value.");
-                    }
-                    else
-                    {
-                        f_resizeVec();
-                    }
+                    SerializeArithmaticArray<T, byteType, endianess>(
+                        std::to_address(begin),
+                        arraySize,
+                        std::to_address(m_CurrentLoc));
+                    m_CurrentLoc += arraySize * sizeof(T);
                 }
-                else
+            }
+            else
+            {
+                for (auto it = begin; it != end; ++it)
                 {
-                    if (m_UseExternalMem)
-                    {
-                        assert(availableSize >= size);
-                    }
-                    else
-                    {
-                        f_resizeVec();
-                    }
+                    writeNumUnchecked<T>(*it);
                 }
             }
         }
 
-      private:
-        bool                       m_UseExternalMem;
-        std::vector<unsigned char> m_MemBuffer;
-        INPUT_IT                    m_Begin;
-        INPUT_IT                    m_End;
-        INPUT_IT                    m_CurrentLoc;
+        /**
+         * Write raw bytes at the current location, memory must already be prepared.
+         */
+        void writeBytesUnchecked(std::span<const std::byte> bytes)
+        {
+            if constexpr (std::contiguous_iterator<INPUT_IT>)
+            {
+                if (!bytes.empty())
+                {
+                    std::memcpy(std::to_address(m_CurrentLoc), bytes.data(), bytes.size());
+                }
+                m_CurrentLoc += bytes.size();
+            }
+            else
+            {
+                for (std::byte byte : bytes)
+                {
+                    *m_CurrentLoc = static_cast<byteType>(byte);
+                    ++m_CurrentLoc;
+                }
+            }
+        }
+
+        /**
+         * Write numeric value at the current location, memory must already be prepared.
+         * Contiguous buffers use the fixed size serializer so no size check or byte loop is needed.
+         */
+        template <class T>
+        void writeNumUnchecked(T value)
+        {
+            if constexpr (std::contiguous_iterator<INPUT_IT>)
+            {
+                SerializeArithmaticType<T, endianess>(value, std::to_address(m_CurrentLoc));
+            }
+            else
+            {
+                SerializeArithmaticType<T, INPUT_IT, endianess, UseExceptions>(
+                    value,
+                    m_CurrentLoc,
+                    m_CurrentLoc + sizeof(T));
+            }
+            m_CurrentLoc += sizeof(T);
+        }
+
+        /**
+         * Read numeric value at the current location, availability must already be checked.
+         */
+        template <class T>
+        T readNumUnchecked()
+        {
+            T value;
+            if constexpr (std::contiguous_iterator<INPUT_IT>)
+            {
+                value = DeSerializeArithmaticType<T, endianess>(std::to_address(m_CurrentLoc));
+            }
+            else
+            {
+                value = DeSerializeArithmaticType<T, INPUT_IT, endianess, UseExceptions>(
+                    m_CurrentLoc,
+                    m_CurrentLoc + sizeof(T));
+            }
+            m_CurrentLoc += sizeof(T);
+
+            return value;
+        }
+
+        static size_t lengthPrefixSize(size_t arraySize, LengthPrefix prefix)
+        {
+            return prefix == LengthPrefix::Fixed ? sizeof(size_t) : VarintSize(arraySize);
+        }
+
+        /**
+         * Write array element count, memory must already be prepared.
+         */
+        void writeLengthPrefix(size_t arraySize, LengthPrefix prefix)
+        {
+            if (prefix == LengthPrefix::Fixed)
+            {
+                writeNumUnchecked(arraySize);
+            }
+            else
+            {
+                writeVarintUnchecked(arraySize);
+            }
+        }
+
+        size_t readLengthPrefix(LengthPrefix prefix)
+        {
+            return prefix == LengthPrefix::Fixed ? ReadNum<size_t>() : static_cast<size_t>(readVarintRaw());
+        }
+
+        /**
+         * Write varint at the current location, memory must already be prepared.
+         */
+        void writeVarintUnchecked(uint64_t rawValue)
+        {
+            if constexpr (std::contiguous_iterator<INPUT_IT>)
+            {
+                m_CurrentLoc += EncodeVarint(rawValue, std::to_address(m_CurrentLoc));
+            }
+            else
+            {
+                byteType encoded[MaxVarintSize<uint64_t>];
+                m_CurrentLoc = std::copy_n(encoded, EncodeVarint(rawValue, encoded), m_CurrentLoc);
+            }
+        }
+
+        uint64_t readVarintRaw()
+        {
+            size_t   available = std::distance(m_CurrentLoc, m_End);
+            uint64_t rawValue{0};
+            size_t   numBytes{0};
+            if constexpr (std::contiguous_iterator<INPUT_IT>)
+            {
+                auto pBegin = std::to_address(m_CurrentLoc);
+                numBytes    = DecodeVarint(pBegin, pBegin + available, rawValue);
+            }
+            else
+            {
+                byteType encoded[MaxVarintSize<uint64_t>];
+                size_t   numEncoded = std::min(available, MaxVarintSize<uint64_t>);
+                std::copy_n(m_CurrentLoc, numEncoded, encoded);
+                numBytes = DecodeVarint(encoded, encoded + numEncoded, rawValue);
+            }
+
+            if (numBytes == 0)
+            {
+                invalidVarint();
+                return 0;
+            }
+
+            m_CurrentLoc += numBytes;
+            return rawValue;
+        }
+
+        void invalidVarint()
+        {
+            if constexpr (UseExceptions)
+            {
+                throw std::runtime_error("Invalid or truncated varint.");
+            }
+            else
+            {
+                assert(false && "Invalid or truncated varint.");
+            }
+        }
+
+        /**
+         * @return Iterator/Pointer to the first element of the managed buffer.
+         */
+        INPUT_IT managedBegin()
+        {
+            if constexpr (std::is_pointer<INPUT_IT>::value)
+            {
+                return reinterpret_cast<INPUT_IT>(m_MemBuffer.data());
+            }
+            else if constexpr (std::is_convertible<typename bufferType::iterator, INPUT_IT>::value)
+            {
+                return m_MemBuffer.begin();
+            }
+            else
+            {
+                // Only reachable for external storage, see the managed buffer constructor.
+                return INPUT_IT();
+            }
+        }
+
+        /**
+         * Resize the managed buffer to capacity bytes and rebase the iterators onto the new storage.
+         * @param capacity: New size of the managed buffer.
+         */
+        void reallocate(size_t capacity)
+        {
+            size_t loc  = std::distance(m_Begin, m_CurrentLoc);
+            size_t size = std::distance(m_Begin, m_End);
+
+            m_MemBuffer.resize(capacity);
+
+            m_Begin      = managedBegin();
+            m_End        = m_Begin + size;
+            m_CurrentLoc = m_Begin + loc;
+        }
+
+        bool       m_UseExternalMem;
+        bufferType m_MemBuffer;
+        INPUT_IT   m_Begin;
+        INPUT_IT   m_End;
+        INPUT_IT   m_CurrentLoc;
     };
 
+    /**
+     * BinaryWriter for network byte order (big endian) wire formats.
+     */
+    template <class INPUT_IT = std::vector<unsigned char>::iterator, bool UseExceptions = true>
+    using BigEndianBinaryWriter = BinaryWriter<INPUT_IT, UseExceptions, Endianess::BigEndian>;
+
+    namespace pmr {
+        /**
+         * BinaryWriter managing its buffer through a std::pmr::memory_resource such as an arena or BufferPool.
+         */
+        template <bool UseExceptions = true, Endianess endianess = Endianess::LittleEndian>
+        using BinaryWriter = Shared::BinaryWriter<
+            unsigned char*,
+            UseExceptions,
+            endianess,
+            DefaultBoundsPolicy<UseExceptions>,
+            std::pmr::polymorphic_allocator<unsigned char>>;
+    } // namespace pmr
 } // namespace Shared
\ No newline at end of file
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "SerializeDeserializeHelpers.hpp"
+#include "SerializeDeserializeNum.hpp"
 
 #include <bitset>
 #include <memory>
@@ -0,0 +1,350 @@
+#pragma once
+
+#include "BitSetTemplate.hpp"
+#include "BoundsPolicy.hpp"
+#include "Enum/Enum.hpp"
+#include "FixedPoint.hpp"
+#include "SerializeDeserializeNum.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace Shared {
+    /**
+     * Bit streams are packed LSB first: the first field occupies the lowest bits of the first byte. Whole
+     * 64 bit words are stored little endian, so the layout does not depend on the host byte order.
+     */
+
+    /**
+     * @return Mask with the lowest numBits bits set, numBits may be 0 to 64.
+     */
+    constexpr uint64_t LowBitMask(size_t numBits)
+    {
+        return numBits >= 64 ? ~uint64_t(0) : (uint64_t(1) << numBits) - 1;
+    }
+
+    /**
+     * @return Number of bits needed to store every value of an Enum, as an offset from FIRST.
+     */
+    template <class T_ENUM, T_ENUM ENUM_BEGIN, T_ENUM ENUM_END, class T_INT, class Derived>
+    constexpr size_t EnumBitWidth(const Enum<T_ENUM, ENUM_BEGIN, ENUM_END, T_INT, Derived>*)
+    {
+        return std::bit_width(static_cast<uint64_t>(static_cast<T_INT>(ENUM_END) - static_cast<T_INT>(ENUM_BEGIN)));
+    }
+
+    /**
+     * @return Number of bits needed to store every valid value of a BitSetTemplate.
+     */
+    template <class BIT_ID_TYPE, class BASE_TYPE, BASE_TYPE VALIDITY_MASK>
+    constexpr size_t BitSetBitWidth(const BitSetTemplate<BIT_ID_TYPE, BASE_TYPE, VALIDITY_MASK>*)
+    {
+        return std::bit_width(static_cast<std::make_unsigned_t<BASE_TYPE>>(VALIDITY_MASK));
+    }
+
+    /**
+     * Writer packing fields of arbitrary bit width.
+     * Fields are collected in a 64 bit accumulator and appended to the buffer a whole word at a time, so a
+     * field costs a few shifts regardless of its width.
+     */
+    class BitWriter {
+      public:
+        /**
+         * @param initialCapacity: Number of bytes to reserve in the output buffer.
+         */
+        explicit BitWriter(size_t initialCapacity = 0)
+            : m_Accumulator(0)
+            , m_NumBits(0)
+        {
+            m_Buffer.reserve(initialCapacity);
+        }
+
+        /**
+         * Discard all written bits, keeping the buffer capacity.
+         */
+        void Clear()
+        {
+            m_Buffer.clear();
+            m_Accumulator = 0;
+            m_NumBits     = 0;
+        }
+
+        /**
+         * @return Number of bits written so far, including alignment padding.
+         */
+        size_t GetBitSize() const { return m_Buffer.size() * 8 + m_NumBits; }
+
+        /**
+         * Write the lowest numBits bits of a value.
+         * @param numBits: Field width, 0 to 64.
+         */
+        void WriteBits(uint64_t value, size_t numBits)
+        {
+            assert(numBits <= 64);
+            if (numBits == 0)
+                return;
+
+            value &= LowBitMask(numBits);
+            m_Accumulator |= value << m_NumBits;
+
+            size_t freeBits = 64 - m_NumBits;
+            if (numBits < freeBits)
+            {
+                m_NumBits += numBits;
+                return;
+            }
+
+            flushWord();
+            m_Accumulator = numBits == freeBits ? 0 : value >> freeBits;
+            m_NumBits     = numBits - freeBits;
+        }
+
+        /**
+         * Write a signed value as a numBits wide two's complement field.
+         */
+        void WriteSignedBits(int64_t value, size_t numBits) { WriteBits(static_cast<uint64_t>(value), numBits); }
+
+        void WriteBool(bool value) { WriteBits(value ? 1 : 0, 1); }
+
+        /**
+         * Write a BitSetTemplate using only the bits up to the highest bit of its validity mask.
+         */
+        template <class BIT_ID_TYPE, class BASE_TYPE, BASE_TYPE VALIDITY_MASK>
+        void Write(const BitSetTemplate<BIT_ID_TYPE, BASE_TYPE, VALIDITY_MASK>& value)
+        {
+            typedef BitSetTemplate<BIT_ID_TYPE, BASE_TYPE, VALIDITY_MASK> bitSetType;
+
+            constexpr size_t numBits = BitSetBitWidth(static_cast<const bitSetType*>(nullptr));
+            WriteBits(static_cast<uint64_t>(value.GetRawValue()), numBits);
+        }
+
+        /**
+         * Write an Enum as its offset from FIRST, using the minimal bit width for the FIRST to LAST range.
+         */
+        template <class T_ENUM, T_ENUM ENUM_BEGIN, T_ENUM ENUM_END, class T_INT, class Derived>
+        void Write(const Enum<T_ENUM, ENUM_BEGIN, ENUM_END, T_INT, Derived>& value)
+        {
+            typedef Enum<T_ENUM, ENUM_BEGIN, ENUM_END, T_INT, Derived> enumType;
+
+            constexpr size_t numBits = EnumBitWidth(static_cast<const enumType*>(nullptr));
+            WriteBits(static_cast<uint64_t>(value.ToIntegral() - static_cast<T_INT>(ENUM_BEGIN)), numBits);
+        }
+
+        /**
+         * Write a FixedPoint as its INT_BITS + FRAC_BITS wide integral representation.
+         */
+        template <class BASE_TYPE, size_t INT_BITS, size_t FRAC_BITS>
+        void Write(const FixedPoint<BASE_TYPE, INT_BITS, FRAC_BITS>& value)
+        {
+            WriteBits(static_cast<uint64_t>(value.ToIntegral()), INT_BITS + FRAC_BITS);
+        }
+
+        /**
+         * Pad with zero bits up to the next byte boundary.
+         */
+        void AlignToByte() { WriteBits(0, (8 - m_NumBits % 8) % 8); }
+
+        /**
+         * Align to a byte boundary and move all pending bits to the buffer.
+         * @return All bytes written so far, valid until the next write.
+         */
+        std::span<const std::byte> Flush()
+        {
+            AlignToByte();
+            for (; m_NumBits > 0; m_NumBits -= 8)
+            {
+                m_Buffer.push_back(static_cast<unsigned char>(m_Accumulator));
+                m_Accumulator >>= 8;
+            }
+            m_Accumulator = 0;
+
+            return GetBuffer();
+        }
+
+        /**
+         * @return Bytes moved to the buffer so far, use Flush() to include pending bits.
+         */
+        std::span<const std::byte> GetBuffer() const { return std::as_bytes(std::span(m_Buffer)); }
+
+      private:
+        void flushWord()
+        {
+            size_t size = m_Buffer.size();
+            m_Buffer.resize(size + sizeof(uint64_t));
+            SerializeArithmaticType<uint64_t, Endianess::LittleEndian>(m_Accumulator, m_Buffer.data() + size);
+        }
+
+        std::vector<unsigned char> m_Buffer;
+        uint64_t                   m_Accumulator;
+        size_t                     m_NumBits;
+    };
+
+    /**
+     * Reader for bit streams written by BitWriter.
+     * The accumulator is refilled a whole 64 bit word at a time while enough bytes remain.
+     * @tparam UseExceptions: If false code uses assert() instead of throwing exceptions when reading past
+     * the end or reading invalid Enum/BitSetTemplate values
+     */
+    template <bool UseExceptions = true>
+    class BitReader {
+      public:
+        explicit BitReader(std::span<const std::byte> bytes)
+            : m_pData(reinterpret_cast<const unsigned char*>(bytes.data()))
+            , m_Size(bytes.size())
+            , m_Position(0)
+            , m_Accumulator(0)
+            , m_NumBits(0)
+        {
+        }
+
+        BitReader(const unsigned char* pData, size_t size)
+            : BitReader(std::as_bytes(std::span<const unsigned char>(pData, size)))
+        {
+        }
+
+        /**
+         * @return Number of bits consumed so far.
+         */
+        size_t GetBitPosition() const { return m_Position * 8 - m_NumBits; }
+
+        size_t GetRemainingBits() const { return (m_Size - m_Position) * 8 + m_NumBits; }
+
+        /**
+         * Read a numBits wide field.
+         * @param numBits: Field width, 0 to 64.
+         */
+        uint64_t ReadBits(size_t numBits)
+        {
+            assert(numBits <= 64);
+            if (numBits <= m_NumBits)
+            {
+                uint64_t value = m_Accumulator & LowBitMask(numBits);
+                m_Accumulator  = numBits == 64 ? 0 : m_Accumulator >> numBits;
+                m_NumBits -= numBits;
+                return value;
+            }
+
+            if (numBits > GetRemainingBits())
+            {
+                DefaultBoundsPolicy<UseExceptions>::OutOfBounds("Read past the end of the bit stream.");
+                return 0;
+            }
+
+            // Take what is left in the accumulator and the rest from the next word.
+            uint64_t value        = m_Accumulator;
+            size_t   numTaken     = m_NumBits;
+            size_t   numRemaining = numBits - numTaken;
+            refill();
+
+            value |= (m_Accumulator & LowBitMask(numRemaining)) << numTaken;
+            m_Accumulator = numRemaining == 64 ? 0 : m_Accumulator >> numRemaining;
+            m_NumBits -= numRemaining;
+            return value;
+        }
+
+        /**
+         * Read a numBits wide two's complement field and sign extend it.
+         */
+        int64_t ReadSignedBits(size_t numBits)
+        {
+            uint64_t value = ReadBits(numBits);
+            if (numBits == 0 || numBits >= 64)
+                return static_cast<int64_t>(value);
+
+            uint64_t signBit = uint64_t(1) << (numBits - 1);
+            return static_cast<int64_t>((value ^ signBit) - signBit);
+        }
+
+        bool ReadBool() { return ReadBits(1) != 0; }
+
+        template <class BIT_ID_TYPE, class BASE_TYPE, BASE_TYPE VALIDITY_MASK>
+        void Read(BitSetTemplate<BIT_ID_TYPE, BASE_TYPE, VALIDITY_MASK>& value)
+        {
+            typedef BitSetTemplate<BIT_ID_TYPE, BASE_TYPE, VALIDITY_MASK> bitSetType;
+
+            constexpr size_t numBits  = BitSetBitWidth(static_cast<const bitSetType*>(nullptr));
+            BASE_TYPE        rawValue = static_cast<BASE_TYPE>(ReadBits(numBits));
+            if constexpr (!UseExceptions)
+            {
+                if (!bitSetType::IsValueValid(rawValue))
+                {
+                    assert(false && "Invalid bit set value.");
+                    return;
+                }
+            }
+            value = bitSetType(rawValue);
+        }
+
+        template <class T_ENUM, T_ENUM ENUM_BEGIN, T_ENUM ENUM_END, class T_INT, class Derived>
+        void Read(Enum<T_ENUM, ENUM_BEGIN, ENUM_END, T_INT, Derived>& value)
+        {
+            typedef Enum<T_ENUM, ENUM_BEGIN, ENUM_END, T_INT, Derived> enumType;
+
+            constexpr size_t numBits  = EnumBitWidth(static_cast<const enumType*>(nullptr));
+            T_INT            rawValue = static_cast<T_INT>(ReadBits(numBits) + static_cast<T_INT>(ENUM_BEGIN));
+            if constexpr (!UseExceptions)
+            {
+                if (!value.IsValid(rawValue))
+                {
+                    assert(false && "Invalid enum value.");
+                    return;
+                }
+            }
+            value.FromIntegral(rawValue);
+        }
+
+        template <class BASE_TYPE, size_t INT_BITS, size_t FRAC_BITS>
+        void Read(FixedPoint<BASE_TYPE, INT_BITS, FRAC_BITS>& value)
+        {
+            constexpr size_t numBits = INT_BITS + FRAC_BITS;
+            if constexpr (std::is_signed_v<BASE_TYPE>)
+            {
+                value = FixedPoint<BASE_TYPE, INT_BITS, FRAC_BITS>(static_cast<BASE_TYPE>(ReadSignedBits(numBits)));
+            }
+            else
+            {
+                value = FixedPoint<BASE_TYPE, INT_BITS, FRAC_BITS>(static_cast<BASE_TYPE>(ReadBits(numBits)));
+            }
+        }
+
+        /**
+         * Skip the padding written by BitWriter::AlignToByte().
+         */
+        void AlignToByte() { ReadBits(m_NumBits % 8); }
+
+      private:
+        /**
+         * Load the next word, or the remaining bytes near the end, into the empty accumulator.
+         */
+        void refill()
+        {
+            size_t available = m_Size - m_Position;
+            if (available >= sizeof(uint64_t))
+            {
+                m_Accumulator = DeSerializeArithmaticType<uint64_t, Endianess::LittleEndian>(m_pData + m_Position);
+                m_Position += sizeof(uint64_t);
+                m_NumBits = 64;
+                return;
+            }
+
+            m_Accumulator = 0;
+            for (size_t i = 0; i < available; ++i)
+            {
+                m_Accumulator |= static_cast<uint64_t>(m_pData[m_Position + i]) << (8 * i);
+            }
+            m_Position += available;
+            m_NumBits = available * 8;
+        }
+
+        const unsigned char* m_pData;
+        size_t               m_Size;
+        size_t               m_Position;
+        uint64_t             m_Accumulator;
+        size_t               m_NumBits;
+    };
+} // namespace Shared
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cassert>
+#include <stdexcept>
+#include <type_traits>
+
+namespace Shared
+{
+    /**
+     * Bounds check policies for BinaryWriter.
+     * The policy is a template parameter so the check is resolved at compile time and inlined into every
+     * read/write instead of going through a virtual call.
+     */
+
+    /**
+     * Throw std::runtime_error when a read/write would leave the buffer.
+     */
+    struct ThrowOnOutOfBounds
+    {
+        static constexpr bool CheckBounds = true;
+
+        [[noreturn]] static void OutOfBounds(const char* message) { throw std::runtime_error(message); }
+    };
+
+    /**
+     * assert() when a read/write would leave the buffer.
+     * The bounds comparison stays in release builds, where it still grows managed buffers. Only the assert()
+     * is compiled out, so an out of bounds access on an external buffer is not caught there.
+     */
+    struct AssertOnOutOfBounds
+    {
+        static constexpr bool CheckBounds = true;
+
+        static void OutOfBounds([[maybe_unused]] const char* message) { assert(false && message); }
+    };
+
+    /**
+     * Skip bounds checks entirely. Managed buffers do not grow either, so capacity has to be reserved up
+     * front (BinaryWriter::Reserve) before writing.
+     */
+    struct UncheckedBounds
+    {
+        static constexpr bool CheckBounds = false;
+
+        static void OutOfBounds(const char*) {}
+    };
+
+    template<bool UseExceptions>
+    using DefaultBoundsPolicy = typename std::conditional<UseExceptions, ThrowOnOutOfBounds, AssertOnOutOfBounds>::type;
+} // namespace Shared
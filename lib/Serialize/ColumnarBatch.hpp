@@ -0,0 +1,410 @@
+#pragma once
+
+#include "MessageView.hpp"
+#include "SerializeDeserializeNum.hpp"
+#include "StructSerializer.hpp"
+#include "Varint.hpp"
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Shared {
+    /**
+     * Encoding of a single column in a columnar batch.
+     */
+    enum class ColumnEncoding : uint8_t
+    {
+        Raw,         ///< Fixed size wire format of the field, any field type
+        Varint,      ///< Varint per value, integral fields only
+        DeltaVarint, ///< Varint of the difference to the previous value, integral fields only
+    };
+
+    /**
+     * @return Number of fields listed in a FieldList.
+     */
+    template <auto... MEMBERS>
+    constexpr size_t FieldListCount(FieldList<MEMBERS...>)
+    {
+        return sizeof...(MEMBERS);
+    }
+
+    /**
+     * @return Position of MEMBER in a FieldList, the number of fields if it is not listed.
+     */
+    template <auto MEMBER, auto... MEMBERS>
+    constexpr size_t FieldListIndex(FieldList<MEMBERS...>)
+    {
+        size_t index{0};
+        bool   found{false};
+        ((found = found || IsSameMember<MEMBER, MEMBERS>(), index += found ? 0 : 1), ...);
+
+        return index;
+    }
+
+    /**
+     * Call func.template operator()<MEMBER, INDEX>() for every field of a FieldList.
+     */
+    template <auto... MEMBERS, class FUNC>
+    void ForEachField(FieldList<MEMBERS...>, FUNC&& func)
+    {
+        [&]<size_t... INDICES>(std::index_sequence<INDICES...>) {
+            (func.template operator()<MEMBERS, INDICES>(), ...);
+        }(std::index_sequence_for<decltype(MEMBERS)...>());
+    }
+
+    /**
+     * @return true if a field type can be stored with the given column encoding.
+     */
+    template <class F>
+    constexpr bool IsColumnEncodingSupported(ColumnEncoding encoding)
+    {
+        return encoding == ColumnEncoding::Raw || (std::is_integral_v<F> && !std::is_same_v<F, bool>);
+    }
+
+    /**
+     * Layout of a batch: varint row count, then for every field of StructFields<T> in order one column made of
+     * a 1 byte ColumnEncoding, the varint byte size of the column data and the column data. Raw columns hold
+     * the wire format of every value back to back, so they can be decoded with a single copy. The byte size
+     * allows readers to skip columns they are not interested in.
+     */
+
+    /**
+     * Writer for batches of records in column (struct of arrays) order.
+     * @tparam T: Record type described by StructFields<T>
+     * @tparam UseExceptions: If false code uses assert() instead of throwing exceptions for unsupported
+     * column encodings
+     * @tparam endianess: Byte order of Raw columns
+     */
+    template <class T, bool UseExceptions = true, Endianess endianess = Endianess::LittleEndian>
+    class ColumnarBatchWriter {
+        typedef typename StructFields<T>::fieldListType fieldListType;
+
+      public:
+        static constexpr size_t NumColumns = FieldListCount(fieldListType{});
+
+        typedef std::array<ColumnEncoding, NumColumns> encodingsType;
+
+        /**
+         * @param encodings: Encoding of each column in StructFields<T> order, all Raw by default.
+         */
+        explicit ColumnarBatchWriter(const encodingsType& encodings = encodingsType{})
+            : m_Encodings(encodings)
+        {
+            ForEachField(fieldListType{}, [&]<auto MEMBER, size_t INDEX>() {
+                if (!IsColumnEncodingSupported<MemberFieldType<MEMBER>>(m_Encodings[INDEX]))
+                {
+                    if constexpr (UseExceptions)
+                    {
+                        throw std::invalid_argument("Varint column encodings require integral fields.");
+                    }
+                    else
+                    {
+                        assert(false && "Varint column encodings require integral fields.");
+                    }
+                    m_Encodings[INDEX] = ColumnEncoding::Raw;
+                }
+            });
+        }
+
+        /**
+         * Select the encoding of the column holding MEMBER.
+         */
+        template <auto MEMBER>
+        static void SetEncoding(encodingsType& encodings, ColumnEncoding encoding)
+        {
+            constexpr size_t index = FieldListIndex<MEMBER>(fieldListType{});
+            static_assert(index < NumColumns, "MEMBER is not listed in StructFields<T>.");
+            encodings[index] = encoding;
+        }
+
+        /**
+         * Write a batch of records.
+         * @param writer: BinaryWriter (or compatible writer) receiving the batch.
+         */
+        template <class WRITER>
+        void Write(WRITER& writer, std::span<const T> records)
+        {
+            writer.WriteVarint(static_cast<uint64_t>(records.size()));
+            ForEachField(fieldListType{}, [&]<auto MEMBER, size_t INDEX>() {
+                encodeColumn<MEMBER>(m_Encodings[INDEX], records);
+
+                writer.WriteNum(static_cast<uint8_t>(m_Encodings[INDEX]));
+                writer.WriteVarint(static_cast<uint64_t>(m_Column.size()));
+                writer.WriteBytes(m_Column);
+            });
+        }
+
+      private:
+        template <auto MEMBER>
+        void encodeColumn(ColumnEncoding encoding, std::span<const T> records)
+        {
+            typedef MemberFieldType<MEMBER> fieldType;
+
+            m_Column.clear();
+            if (encoding == ColumnEncoding::Raw)
+            {
+                constexpr size_t size = WireFormat<fieldType>::Size;
+                m_Column.resize(records.size() * size);
+                for (size_t i = 0; i < records.size(); ++i)
+                {
+                    WireFormat<fieldType>::template Write<endianess>(records[i].*MEMBER, m_Column.data() + i * size);
+                }
+                return;
+            }
+
+            if constexpr (IsColumnEncodingSupported<fieldType>(ColumnEncoding::Varint))
+            {
+                typedef std::make_unsigned_t<fieldType> unsignedType;
+                typedef std::make_signed_t<fieldType>   signedType;
+
+                m_Column.resize(records.size() * MaxVarintSize<fieldType>);
+                size_t       size{0};
+                unsignedType previous{0};
+                for (const T& record : records)
+                {
+                    fieldType value = record.*MEMBER;
+                    if (encoding == ColumnEncoding::DeltaVarint)
+                    {
+                        // The difference is taken modulo 2^N, so it always fits in the field type.
+                        unsignedType delta = static_cast<unsignedType>(static_cast<unsignedType>(value) - previous);
+                        previous           = static_cast<unsignedType>(value);
+                        size += EncodeVarint(ToVarintValue(static_cast<signedType>(delta)), m_Column.data() + size);
+                    }
+                    else
+                    {
+                        size += EncodeVarint(ToVarintValue(value), m_Column.data() + size);
+                    }
+                }
+                m_Column.resize(size);
+            }
+        }
+
+        encodingsType          m_Encodings;
+        std::vector<std::byte> m_Column;
+    };
+
+    /**
+     * Reader for batches written by ColumnarBatchWriter.
+     * Read() only locates the columns, which are then decoded one at a time into plain arrays with
+     * ReadColumn() or all at once into records with ReadRecords(). The buffer the batch was read from must
+     * outlive the reader.
+     * @tparam T: Record type described by StructFields<T>
+     * @tparam UseExceptions: If false code uses assert() instead of throwing exceptions for malformed batches
+     * @tparam endianess: Byte order of Raw columns
+     */
+    template <class T, bool UseExceptions = true, Endianess endianess = Endianess::LittleEndian>
+    class ColumnarBatchReader {
+        typedef typename StructFields<T>::fieldListType fieldListType;
+
+      public:
+        static constexpr size_t NumColumns = FieldListCount(fieldListType{});
+
+        ColumnarBatchReader()
+            : m_NumRows(0)
+            , m_Columns{}
+        {
+        }
+
+        /**
+         * Read the batch header and locate all columns.
+         * @param reader: BinaryWriter (or compatible reader) positioned at the start of a batch.
+         */
+        template <class READER>
+        void Read(READER& reader)
+        {
+            m_NumRows = reader.template ReadVarint<uint64_t>();
+            ForEachField(fieldListType{}, [&]<auto MEMBER, size_t INDEX>() {
+                Column& column  = m_Columns[INDEX];
+                column.Encoding = static_cast<ColumnEncoding>(reader.template ReadNum<uint8_t>());
+                column.Bytes    = reader.ReadBytes(reader.template ReadVarint<uint64_t>());
+
+                bool isValid = IsColumnEncodingSupported<MemberFieldType<MEMBER>>(column.Encoding) &&
+                               column.Encoding <= ColumnEncoding::DeltaVarint &&
+                               (column.Encoding != ColumnEncoding::Raw ||
+                                (column.Bytes.size() / WireFormat<MemberFieldType<MEMBER>>::Size == m_NumRows &&
+                                 column.Bytes.size() % WireFormat<MemberFieldType<MEMBER>>::Size == 0));
+                if (!isValid)
+                {
+                    invalidBatch();
+                }
+            });
+        }
+
+        size_t GetRowCount() const { return m_NumRows; }
+
+        template <auto MEMBER>
+        ColumnEncoding GetEncoding() const
+        {
+            return m_Columns[columnIndex<MEMBER>()].Encoding;
+        }
+
+        /**
+         * Decode the column holding MEMBER into an array.
+         * @param pValues: Destination for GetRowCount() values.
+         */
+        template <auto MEMBER>
+        void ReadColumn(MemberFieldType<MEMBER>* pValues) const
+        {
+            typedef MemberFieldType<MEMBER> fieldType;
+
+            const Column& column = m_Columns[columnIndex<MEMBER>()];
+            if constexpr (WireFormat<fieldType>::RawLayout && IsNativeEndianess<endianess>())
+            {
+                if (column.Encoding == ColumnEncoding::Raw)
+                {
+                    std::memcpy(pValues, column.Bytes.data(), column.Bytes.size());
+                    return;
+                }
+            }
+            else if constexpr (std::is_arithmetic_v<fieldType>)
+            {
+                if (column.Encoding == ColumnEncoding::Raw)
+                {
+                    DeSerializeArithmaticArray<fieldType, std::byte, endianess>(column.Bytes.data(), m_NumRows,
+                                                                                 pValues);
+                    return;
+                }
+            }
+
+            decodeColumn<fieldType>(column, [pValues](size_t row, const fieldType& value) { pValues[row] = value; });
+        }
+
+        template <auto MEMBER>
+        std::vector<MemberFieldType<MEMBER>> ReadColumn() const
+        {
+            typedef MemberFieldType<MEMBER> fieldType;
+
+            std::vector<fieldType> values;
+            if constexpr (std::is_default_constructible_v<fieldType>)
+            {
+                values.resize(m_NumRows);
+                ReadColumn<MEMBER>(values.data());
+            }
+            else
+            {
+                values.reserve(m_NumRows);
+                decodeColumn<fieldType>(m_Columns[columnIndex<MEMBER>()],
+                                        [&values](size_t, const fieldType& value) { values.push_back(value); });
+            }
+            return values;
+        }
+
+        /**
+         * Decode all columns back into records.
+         * @param pRecords: Destination for GetRowCount() records.
+         */
+        void ReadRecords(T* pRecords) const
+        {
+            ForEachField(fieldListType{}, [&]<auto MEMBER, size_t INDEX>() {
+                decodeColumn<MemberFieldType<MEMBER>>(
+                    m_Columns[INDEX],
+                    [pRecords](size_t row, const MemberFieldType<MEMBER>& value) { pRecords[row].*MEMBER = value; });
+            });
+        }
+
+        std::vector<T> ReadRecords() const
+        {
+            std::vector<T> records(m_NumRows);
+            ReadRecords(records.data());
+            return records;
+        }
+
+      private:
+        struct Column
+        {
+            ColumnEncoding             Encoding;
+            std::span<const std::byte> Bytes;
+        };
+
+        template <auto MEMBER>
+        static constexpr size_t columnIndex()
+        {
+            constexpr size_t index = FieldListIndex<MEMBER>(fieldListType{});
+            static_assert(index < NumColumns, "MEMBER is not listed in StructFields<T>.");
+            return index;
+        }
+
+        void invalidBatch() const
+        {
+            if constexpr (UseExceptions)
+            {
+                throw std::runtime_error("Invalid columnar batch.");
+            }
+            else
+            {
+                assert(false && "Invalid columnar batch.");
+            }
+        }
+
+        /**
+         * Decode every value of a column, passing it to store(row, value).
+         */
+        template <class F, class STORE>
+        void decodeColumn(const Column& column, STORE&& store) const
+        {
+            if (column.Encoding == ColumnEncoding::Raw)
+            {
+                constexpr size_t size = WireFormat<F>::Size;
+                for (size_t row = 0; row < m_NumRows; ++row)
+                {
+                    store(row, ReadWireValue<F, endianess>(column.Bytes.data() + row * size));
+                }
+                return;
+            }
+
+            if constexpr (IsColumnEncodingSupported<F>(ColumnEncoding::Varint))
+            {
+                typedef std::make_unsigned_t<F> unsignedType;
+                typedef std::make_signed_t<F>   signedType;
+
+                const std::byte* pSrc = column.Bytes.data();
+                const std::byte* pEnd = pSrc + column.Bytes.size();
+                unsignedType     previous{0};
+                for (size_t row = 0; row < m_NumRows; ++row)
+                {
+                    uint64_t rawValue{0};
+                    size_t   numBytes = DecodeVarint(pSrc, pEnd, rawValue);
+                    if (numBytes == 0)
+                    {
+                        invalidBatch();
+                        return;
+                    }
+                    pSrc += numBytes;
+
+                    if (column.Encoding == ColumnEncoding::DeltaVarint)
+                    {
+                        signedType delta{0};
+                        if (!FromVarintValue(rawValue, delta))
+                        {
+                            invalidBatch();
+                            return;
+                        }
+                        previous = static_cast<unsignedType>(previous + static_cast<unsignedType>(delta));
+                        store(row, static_cast<F>(previous));
+                    }
+                    else
+                    {
+                        F value{0};
+                        if (!FromVarintValue(rawValue, value))
+                        {
+                            invalidBatch();
+                            return;
+                        }
+                        store(row, value);
+                    }
+                }
+            }
+        }
+
+        size_t                         m_NumRows;
+        std::array<Column, NumColumns> m_Columns;
+    };
+} // namespace Shared
@@ -1,79 +1,187 @@
 #pragma once
 
+#include "Int128.hpp"
+
+#include <cassert>
 #include <cmath>
+#include <compare>
+#include <cstdint>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
+#include <utility>
 
 namespace Shared
 {
 
+    /**
+     * Fixed point number stored as a raw BASE_TYPE integer scaled by 2^FRAC_BITS.
+     * Arithmetic runs entirely on integers: intermediates are widened so sums and products cannot overflow
+     * before the result is narrowed. The plain operators wrap around like built-in integers, the Saturating*
+     * variants clamp to [GetMin(), GetMax()]. Multiplication rounds to the nearest step, division truncates
+     * towards zero. 64 bit base types use 128 bit intermediates (Int128), so their arithmetic is exact as well.
+     * The double constructor and ToDouble() are limited to the 53 bit precision of a double, FromInteger() and
+     * FromRatio() convert without going through a double.
+     * For signed types INT_BITS includes the sign bit.
+     */
     template<class BASE_TYPE, size_t INT_BITS, size_t FRAC_BITS>
     class FixedPoint
     {
+        static constexpr bool IsSignedType = std::is_signed<BASE_TYPE>::value;
+
+        // Signed type holding any sum or difference of two raw values.
+        typedef std::conditional_t<(sizeof(BASE_TYPE) <= 2), int32_t,
+                                   std::conditional_t<(sizeof(BASE_TYPE) <= 4), int64_t, Int128>>
+            sumType;
+
+        // Type holding any product of two raw values and any raw value shifted left by FRAC_BITS.
+        typedef std::conditional_t<(sizeof(BASE_TYPE) <= 2),
+                                   std::conditional_t<IsSignedType, int32_t, uint32_t>,
+                                   std::conditional_t<(sizeof(BASE_TYPE) <= 4),
+                                                      std::conditional_t<IsSignedType, int64_t, uint64_t>,
+                                                      std::conditional_t<IsSignedType, Int128, UInt128>>>
+            productType;
+
       public:
-        FixedPoint()
-            : m_FixedPointValue(0.0)
+        static constexpr BASE_TYPE MaxRawValue =
+            static_cast<BASE_TYPE>(~0ULL >> (64 - (INT_BITS + FRAC_BITS - (IsSignedType ? 1 : 0))));
+        static constexpr BASE_TYPE MinRawValue = IsSignedType ? static_cast<BASE_TYPE>(-MaxRawValue) : 0;
+
+        constexpr FixedPoint()
+            : m_RawValue(0)
         {
+            static_assert(std::is_integral<BASE_TYPE>::value, "BASE_TYPE must be integral type.");
             static_assert((sizeof(BASE_TYPE) * 8) >= (INT_BITS + FRAC_BITS),
                           "FRACT_BITS + INT_BITS must be less than or equal to sizeof(BASE_TYPE) * 8");
-            static_assert(sizeof(BASE_TYPE) < 8, "64 bit integers are not supported as base types.");
+            static_assert(sizeof(BASE_TYPE) <= 8, "Integers wider than 64 bits are not supported as base types.");
+            static_assert(INT_BITS + FRAC_BITS > (IsSignedType ? 1 : 0), "FixedPoint needs at least one value bit.");
         }
 
-        FixedPoint(double value)
-            : m_FixedPointValue(Round(value))
+        /**
+         * Convert a double, rounding to the nearest step.
+         * @throws std::out_of_range if value is NaN or outside [GetMin(), GetMax()].
+         */
+        constexpr FixedPoint(double value)
+            : m_RawValue(0)
         {
-            if (value > GetMax()) {
+            if (std::isnan(value)) {
+                throw std::out_of_range("NaN has no fixed point representation.");
+            } else if (value > GetMax()) {
                 throw std::out_of_range(std::to_string(value) + " is greater than max value of " +
                                         std::to_string(GetMax()));
             } else if (value < GetMin()) {
                 throw std::out_of_range(std::to_string(value) + " is less than min value of " +
-                                        std::to_string(GetMax()));
+                                        std::to_string(GetMin()));
             }
-        }
 
-        FixedPoint(BASE_TYPE value)
-            : m_FixedPointValue((double)value * GetStepSize())
-        {
+            // Limits of 64 bit types round up to the next power of two as doubles, clamp before converting.
+            double scaledValue  = value * getScale();
+            double roundedValue = scaledValue < 0 ? scaledValue - 0.5 : scaledValue + 0.5;
+            if (roundedValue >= static_cast<double>(MaxRawValue)) {
+                m_RawValue = MaxRawValue;
+            } else if (roundedValue <= static_cast<double>(MinRawValue)) {
+                m_RawValue = MinRawValue;
+            } else {
+                m_RawValue = static_cast<BASE_TYPE>(roundedValue);
+            }
         }
 
-        ~FixedPoint() {}
-
-        double ToDouble() const { return m_FixedPointValue; }
-        BASE_TYPE ToIntegral() const
+        /**
+         * Construct from the raw integral representation, i.e. value * 2^FRAC_BITS.
+         */
+        constexpr FixedPoint(BASE_TYPE value)
+            : m_RawValue(value)
         {
-            return static_cast<BASE_TYPE>(m_FixedPointValue * ((unsigned long long)1 << FRAC_BITS));
         }
 
-        static bool IsSigned() { return std::is_signed<BASE_TYPE>::value; }
-
-        static size_t GetSize() { return INT_BITS + FRAC_BITS; }
+        static constexpr FixedPoint FromRaw(BASE_TYPE rawValue) { return FixedPoint(rawValue); }
 
-        static double GetMax()
+        /**
+         * Convert an integer exactly.
+         * @throws std::out_of_range if value is outside [GetMin(), GetMax()].
+         */
+        template<class T>
+            requires std::is_integral_v<T>
+        static constexpr FixedPoint FromInteger(T value)
         {
-            unsigned long long maxIntegralValue;
-
-            if (IsSigned()) {
-                maxIntegralValue = ((unsigned long long)1 << (GetSize() - 1)) - 1;
-            } else {
-                maxIntegralValue = ((unsigned long long)1 << GetSize()) - 1;
+            constexpr BASE_TYPE maxInteger = (FRAC_BITS < sizeof(BASE_TYPE) * 8) ? (MaxRawValue >> FRAC_BITS) : 0;
+            constexpr BASE_TYPE minInteger = IsSignedType ? static_cast<BASE_TYPE>(0 - maxInteger) : 0;
+            if (std::cmp_greater(value, maxInteger)) {
+                throw std::out_of_range(std::to_string(value) + " is greater than max value of " +
+                                        std::to_string(GetMax()));
+            } else if (std::cmp_less(value, minInteger)) {
+                throw std::out_of_range(std::to_string(value) + " is less than min value of " +
+                                        std::to_string(GetMin()));
             }
 
-            return (double)maxIntegralValue * GetStepSize();
+            return FromRaw(static_cast<BASE_TYPE>(static_cast<productType>(value) * getOne()));
         }
 
-        static double GetMin()
+        /**
+         * Convert numerator / denominator exactly, rounding to the nearest step (halves away from zero).
+         * E.g. FromRatio(1999, 100) for 19.99 without the representation error of a double literal.
+         * @tparam UseExceptions: If false code uses assert() instead of throwing exceptions, a zero denominator
+         * then returns 0 and results outside [GetMin(), GetMax()] saturate.
+         * @throws std::invalid_argument if denominator is 0.
+         * @throws std::out_of_range if the result is outside [GetMin(), GetMax()].
+         */
+        template<bool UseExceptions = true>
+        static constexpr FixedPoint FromRatio(int64_t numerator, int64_t denominator)
         {
-            if (IsSigned()) {
-                return GetMax() * -1;
-            } else {
-                return 0;
+            if (denominator == 0) {
+                if constexpr (UseExceptions) {
+                    throw std::invalid_argument(std::to_string(numerator) + " / 0 has no value.");
+                } else {
+                    assert(false && "FromRatio() denominator is 0.");
+                    return FixedPoint();
+                }
             }
+
+            auto magnitude = [](int64_t value) {
+                uint64_t bits = static_cast<uint64_t>(value);
+                return static_cast<UInt128>(value < 0 ? 0 - bits : bits);
+            };
+
+            // |numerator| * 2^FRAC_BITS < 2^127 for FRAC_BITS <= 64.
+            bool    negative = (numerator < 0) != (denominator < 0);
+            UInt128 divisor  = magnitude(denominator);
+            UInt128 quotient = ((magnitude(numerator) << FRAC_BITS) + divisor / 2) / divisor;
+            UInt128 limit    = negative ? magnitude(MinRawValue) : static_cast<UInt128>(MaxRawValue);
+            if (quotient > limit) {
+                if constexpr (UseExceptions) {
+                    throw std::out_of_range(std::to_string(numerator) + " / " + std::to_string(denominator) +
+                                            " is outside of [" + std::to_string(GetMin()) + ", " +
+                                            std::to_string(GetMax()) + "]");
+                } else {
+                    assert(false && "FromRatio() result is out of range.");
+                    return FromRaw(negative ? MinRawValue : MaxRawValue);
+                }
+            }
+
+            uint64_t rawBits = static_cast<uint64_t>(quotient);
+            return FromRaw(static_cast<BASE_TYPE>(negative ? 0 - rawBits : rawBits));
         }
 
-        static double GetStepSize() { return double(1.0) / double((unsigned long long)1 << FRAC_BITS); }
+        /**
+         * @return Integer part of the value, truncated towards zero. Unlike ToIntegral() this is not the raw value.
+         */
+        constexpr BASE_TYPE ToInteger() const { return static_cast<BASE_TYPE>(m_RawValue / getOne()); }
+
+        constexpr double ToDouble() const { return static_cast<double>(m_RawValue) / getScale(); }
+        constexpr BASE_TYPE ToIntegral() const { return m_RawValue; }
+
+        static constexpr bool IsSigned() { return IsSignedType; }
+
+        static constexpr size_t GetSize() { return INT_BITS + FRAC_BITS; }
+
+        static constexpr double GetMax() { return static_cast<double>(MaxRawValue) * GetStepSize(); }
+
+        static constexpr double GetMin() { return static_cast<double>(MinRawValue) * GetStepSize(); }
 
-        static size_t GetFractionalBits() { return FRAC_BITS; }
-        static size_t GetIntegerBits() { return INT_BITS; }
+        static constexpr double GetStepSize() { return double(1.0) / getScale(); }
+
+        static constexpr size_t GetFractionalBits() { return FRAC_BITS; }
+        static constexpr size_t GetIntegerBits() { return INT_BITS; }
 
         static double Round(double value)
         {
@@ -93,7 +201,128 @@ namespace Shared
             return value - remainder;
         }
 
+        constexpr FixedPoint WrappingAdd(FixedPoint other) const
+        {
+            return FromRaw(wrap(static_cast<sumType>(m_RawValue) + other.m_RawValue));
+        }
+
+        constexpr FixedPoint WrappingSub(FixedPoint other) const
+        {
+            return FromRaw(wrap(static_cast<sumType>(m_RawValue) - other.m_RawValue));
+        }
+
+        constexpr FixedPoint WrappingMul(FixedPoint other) const { return FromRaw(wrap(multiply(other))); }
+
+        /**
+         * Divide, truncating towards zero. Division by zero is undefined like for built-in integers.
+         */
+        constexpr FixedPoint WrappingDiv(FixedPoint other) const
+        {
+            assert(other.m_RawValue != 0);
+            return FromRaw(wrap((static_cast<productType>(m_RawValue) << FRAC_BITS) / other.m_RawValue));
+        }
+
+        constexpr FixedPoint SaturatingAdd(FixedPoint other) const
+        {
+            return FromRaw(saturate(static_cast<sumType>(m_RawValue) + other.m_RawValue));
+        }
+
+        constexpr FixedPoint SaturatingSub(FixedPoint other) const
+        {
+            return FromRaw(saturate(static_cast<sumType>(m_RawValue) - other.m_RawValue));
+        }
+
+        constexpr FixedPoint SaturatingMul(FixedPoint other) const { return FromRaw(saturate(multiply(other))); }
+
+        /**
+         * Divide, truncating towards zero. Division by zero saturates towards the sign of the dividend.
+         */
+        constexpr FixedPoint SaturatingDiv(FixedPoint other) const
+        {
+            if (other.m_RawValue == 0) {
+                if constexpr (IsSignedType) {
+                    return FromRaw(m_RawValue < 0 ? MinRawValue : MaxRawValue);
+                }
+                return FromRaw(MaxRawValue);
+            }
+
+            return FromRaw(saturate((static_cast<productType>(m_RawValue) << FRAC_BITS) / other.m_RawValue));
+        }
+
+        constexpr FixedPoint operator+(FixedPoint other) const { return WrappingAdd(other); }
+        constexpr FixedPoint operator-(FixedPoint other) const { return WrappingSub(other); }
+        constexpr FixedPoint operator*(FixedPoint other) const { return WrappingMul(other); }
+        constexpr FixedPoint operator/(FixedPoint other) const { return WrappingDiv(other); }
+        constexpr FixedPoint operator-() const { return FromRaw(wrap(-static_cast<sumType>(m_RawValue))); }
+
+        constexpr FixedPoint& operator+=(FixedPoint other) { return *this = *this + other; }
+        constexpr FixedPoint& operator-=(FixedPoint other) { return *this = *this - other; }
+        constexpr FixedPoint& operator*=(FixedPoint other) { return *this = *this * other; }
+        constexpr FixedPoint& operator/=(FixedPoint other) { return *this = *this / other; }
+
+        constexpr bool operator==(const FixedPoint& other) const = default;
+        constexpr auto operator<=>(const FixedPoint& other) const = default;
+
       private:
-        double m_FixedPointValue;
+        static constexpr double getScale()
+        {
+            // Split the shift so FRAC_BITS == 64 stays defined.
+            return static_cast<double>(1ULL << (FRAC_BITS / 2)) *
+                   static_cast<double>(1ULL << (FRAC_BITS - FRAC_BITS / 2));
+        }
+
+        /**
+         * @return 2^FRAC_BITS, the raw value of 1.
+         */
+        static constexpr productType getOne() { return static_cast<productType>(1) << FRAC_BITS; }
+
+        /**
+         * @return Product of the raw values rescaled to FRAC_BITS, rounded to the nearest step.
+         */
+        constexpr productType multiply(FixedPoint other) const
+        {
+            productType product = static_cast<productType>(m_RawValue) * static_cast<productType>(other.m_RawValue);
+            if constexpr (FRAC_BITS > 0) {
+                product += static_cast<productType>(1) << (FRAC_BITS - 1);
+            }
+            return product >> FRAC_BITS;
+        }
+
+        template<class T>
+        static constexpr BASE_TYPE saturate(T value)
+        {
+            if (value > static_cast<T>(MaxRawValue)) {
+                return MaxRawValue;
+            }
+            // Sums of unsigned raw values are signed, std::is_signed doesn't cover Int128 in strict mode.
+            if constexpr (static_cast<T>(-1) < static_cast<T>(0)) {
+                if (value < static_cast<T>(MinRawValue)) {
+                    return MinRawValue;
+                }
+            }
+            return static_cast<BASE_TYPE>(value);
+        }
+
+        /**
+         * Reduce a value modulo 2^(INT_BITS + FRAC_BITS), sign extending for signed types.
+         */
+        template<class T>
+        static constexpr BASE_TYPE wrap(T value)
+        {
+            constexpr size_t numBits = INT_BITS + FRAC_BITS;
+            if constexpr (numBits == sizeof(BASE_TYPE) * 8) {
+                return static_cast<BASE_TYPE>(value);
+            } else {
+                constexpr unsigned long long mask = ((unsigned long long)1 << numBits) - 1;
+
+                unsigned long long bits = static_cast<unsigned long long>(value) & mask;
+                if (IsSignedType && (bits >> (numBits - 1)) != 0) {
+                    bits |= ~mask;
+                }
+                return static_cast<BASE_TYPE>(bits);
+            }
+        }
+
+        BASE_TYPE m_RawValue;
     };
 } // namespace Shared
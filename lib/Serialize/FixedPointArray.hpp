@@ -0,0 +1,319 @@
+#pragma once
+
+#include "FixedPoint.hpp"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace Shared
+{
+    template<class FIXED_TYPE>
+    class FixedPointArray;
+
+    /**
+     * Bulk conversion between floating point arrays and FixedPoint values.
+     * Quantize() rounds half away from zero exactly like FixedPoint(double), but saturates values outside
+     * [GetMin(), GetMax()] instead of throwing and reports how many there were. NaN becomes GetMin().
+     * Dequantize() produces exactly the values of ToDouble().
+     * Blocks of 8 values are converted with AVX2 (when compiled with it) or SSE2 as long as the raw range fits
+     * an int32, remaining values and wider types use the scalar code.
+     */
+    template<class BASE_TYPE, size_t INT_BITS, size_t FRAC_BITS>
+    class FixedPointArray<FixedPoint<BASE_TYPE, INT_BITS, FRAC_BITS>>
+    {
+        typedef FixedPoint<BASE_TYPE, INT_BITS, FRAC_BITS> fixedPointType;
+
+        static constexpr double MinRaw   = static_cast<double>(fixedPointType::MinRawValue);
+        static constexpr double MaxRaw   = static_cast<double>(fixedPointType::MaxRawValue);
+        static constexpr double StepSize = fixedPointType::GetStepSize();
+        static constexpr double Scale    = 1.0 / StepSize;
+
+        static constexpr size_t BlockSize = 8;
+        static constexpr bool   UseSimd =
+            sizeof(BASE_TYPE) <= 4 && static_cast<uint64_t>(fixedPointType::MaxRawValue) <=
+                                          static_cast<uint64_t>(std::numeric_limits<int32_t>::max());
+
+        // Size of the raw buffer used by the FixedPoint overloads.
+        static constexpr size_t ChunkSize = 256;
+
+      public:
+        /**
+         * Convert count values to raw fixed point values, saturating values that are out of range.
+         * @param pSrc: Array of float or double values.
+         * @param count: Number of values to convert.
+         * @param pDest: Destination for count raw values, see FixedPoint::ToIntegral().
+         * @return Number of values that were out of range or NaN.
+         */
+        template<class FLOAT_TYPE>
+        static size_t Quantize(const FLOAT_TYPE* pSrc, size_t count, BASE_TYPE* pDest)
+        {
+            static_assert(std::is_floating_point<FLOAT_TYPE>::value, "FLOAT_TYPE must be floating point type.");
+
+            size_t numOutOfRange{0};
+            size_t i{0};
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+            if constexpr (UseSimd && (std::is_same<FLOAT_TYPE, double>::value ||
+                                      std::is_same<FLOAT_TYPE, float>::value)) {
+                for (size_t simdCount = count - count % BlockSize; i < simdCount; i += BlockSize) {
+                    storeNarrowed(pDest + i, quantizeLanes(pSrc + i, numOutOfRange),
+                                  quantizeLanes(pSrc + i + 4, numOutOfRange));
+                }
+            }
+#endif
+            for (; i < count; ++i) {
+                pDest[i] = quantize(static_cast<double>(pSrc[i]), numOutOfRange);
+            }
+
+            return numOutOfRange;
+        }
+
+        /**
+         * Convert count values to FixedPoint values, saturating values that are out of range.
+         * @return Number of values that were out of range or NaN.
+         */
+        template<class FLOAT_TYPE>
+        static size_t Quantize(const FLOAT_TYPE* pSrc, size_t count, fixedPointType* pDest)
+        {
+            BASE_TYPE rawValues[ChunkSize];
+            size_t    numOutOfRange{0};
+            for (size_t i = 0; i < count; i += ChunkSize) {
+                size_t chunk = count - i < ChunkSize ? count - i : ChunkSize;
+                numOutOfRange += Quantize(pSrc + i, chunk, rawValues);
+                for (size_t j = 0; j < chunk; ++j) {
+                    pDest[i + j] = fixedPointType::FromRaw(rawValues[j]);
+                }
+            }
+
+            return numOutOfRange;
+        }
+
+        /**
+         * Convert count raw fixed point values to float or double.
+         */
+        template<class FLOAT_TYPE>
+        static void Dequantize(const BASE_TYPE* pSrc, size_t count, FLOAT_TYPE* pDest)
+        {
+            static_assert(std::is_floating_point<FLOAT_TYPE>::value, "FLOAT_TYPE must be floating point type.");
+
+            size_t i{0};
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+            if constexpr (UseSimd && (std::is_same<FLOAT_TYPE, double>::value ||
+                                      std::is_same<FLOAT_TYPE, float>::value)) {
+                for (size_t simdCount = count - count % BlockSize; i < simdCount; i += BlockSize) {
+                    __m128i low;
+                    __m128i high;
+                    loadWidened(pSrc + i, low, high);
+                    dequantizeLanes(low, high, pDest + i);
+                }
+            }
+#endif
+            for (; i < count; ++i) {
+                pDest[i] = static_cast<FLOAT_TYPE>(static_cast<double>(pSrc[i]) * StepSize);
+            }
+        }
+
+        /**
+         * Convert count FixedPoint values to float or double.
+         */
+        template<class FLOAT_TYPE>
+        static void Dequantize(const fixedPointType* pSrc, size_t count, FLOAT_TYPE* pDest)
+        {
+            BASE_TYPE rawValues[ChunkSize];
+            for (size_t i = 0; i < count; i += ChunkSize) {
+                size_t chunk = count - i < ChunkSize ? count - i : ChunkSize;
+                for (size_t j = 0; j < chunk; ++j) {
+                    rawValues[j] = pSrc[i + j].ToIntegral();
+                }
+                Dequantize(rawValues, chunk, pDest + i);
+            }
+        }
+
+      private:
+        static BASE_TYPE quantize(double value, size_t& numOutOfRange)
+        {
+            double scaled = value * Scale;
+            if (!(scaled >= MinRaw)) {
+                ++numOutOfRange;
+                scaled = MinRaw;
+            } else if (scaled > MaxRaw) {
+                ++numOutOfRange;
+                scaled = MaxRaw;
+            }
+
+            // Limits of 64 bit types round up to the next power of two as doubles.
+            double rounded = scaled < 0 ? scaled - 0.5 : scaled + 0.5;
+            if (rounded >= MaxRaw) {
+                return fixedPointType::MaxRawValue;
+            } else if (rounded <= MinRaw) {
+                return fixedPointType::MinRawValue;
+            }
+            return static_cast<BASE_TYPE>(rounded);
+        }
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#if defined(__AVX2__)
+        static __m256d loadDoubles(const double* pSrc) { return _mm256_loadu_pd(pSrc); }
+        static __m256d loadDoubles(const float* pSrc) { return _mm256_cvtps_pd(_mm_loadu_ps(pSrc)); }
+
+        /**
+         * Scale, clamp and round 4 values the same way as quantize().
+         * @return 4 raw values as int32.
+         */
+        template<class FLOAT_TYPE>
+        static __m128i quantizeLanes(const FLOAT_TYPE* pSrc, size_t& numOutOfRange)
+        {
+            const __m256d minRaw = _mm256_set1_pd(MinRaw);
+            const __m256d maxRaw = _mm256_set1_pd(MaxRaw);
+
+            __m256d scaled  = _mm256_mul_pd(loadDoubles(pSrc), _mm256_set1_pd(Scale));
+            __m256d inRange = _mm256_and_pd(_mm256_cmp_pd(scaled, minRaw, _CMP_GE_OQ),
+                                            _mm256_cmp_pd(scaled, maxRaw, _CMP_LE_OQ));
+            unsigned int inRangeMask = static_cast<unsigned int>(_mm256_movemask_pd(inRange));
+            if (inRangeMask != 0xF) {
+                numOutOfRange += 4 - std::popcount(inRangeMask);
+            }
+
+            // max returns its second operand if either is NaN, so NaN ends up as MinRaw.
+            scaled       = _mm256_min_pd(_mm256_max_pd(scaled, minRaw), maxRaw);
+            __m256d half = _mm256_or_pd(_mm256_and_pd(scaled, _mm256_set1_pd(-0.0)), _mm256_set1_pd(0.5));
+            return _mm256_cvttpd_epi32(_mm256_add_pd(scaled, half));
+        }
+
+        static void dequantizeLanes(__m128i low, __m128i high, double* pDest)
+        {
+            const __m256d stepSize = _mm256_set1_pd(StepSize);
+            _mm256_storeu_pd(pDest, _mm256_mul_pd(_mm256_cvtepi32_pd(low), stepSize));
+            _mm256_storeu_pd(pDest + 4, _mm256_mul_pd(_mm256_cvtepi32_pd(high), stepSize));
+        }
+
+        static void dequantizeLanes(__m128i low, __m128i high, float* pDest)
+        {
+            __m256 values = _mm256_cvtepi32_ps(_mm256_set_m128i(high, low));
+            _mm256_storeu_ps(pDest, _mm256_mul_ps(values, _mm256_set1_ps(static_cast<float>(StepSize))));
+        }
+#else
+        static __m128i quantizePair(__m128d value, size_t& numOutOfRange)
+        {
+            const __m128d minRaw = _mm_set1_pd(MinRaw);
+            const __m128d maxRaw = _mm_set1_pd(MaxRaw);
+
+            __m128d scaled  = _mm_mul_pd(value, _mm_set1_pd(Scale));
+            __m128d inRange = _mm_and_pd(_mm_cmpge_pd(scaled, minRaw), _mm_cmple_pd(scaled, maxRaw));
+            unsigned int inRangeMask = static_cast<unsigned int>(_mm_movemask_pd(inRange));
+            if (inRangeMask != 0x3) {
+                numOutOfRange += 2 - std::popcount(inRangeMask);
+            }
+
+            // max returns its second operand if either is NaN, so NaN ends up as MinRaw.
+            scaled       = _mm_min_pd(_mm_max_pd(scaled, minRaw), maxRaw);
+            __m128d half = _mm_or_pd(_mm_and_pd(scaled, _mm_set1_pd(-0.0)), _mm_set1_pd(0.5));
+            return _mm_cvttpd_epi32(_mm_add_pd(scaled, half));
+        }
+
+        /**
+         * Scale, clamp and round 4 values the same way as quantize().
+         * @return 4 raw values as int32.
+         */
+        static __m128i quantizeLanes(const double* pSrc, size_t& numOutOfRange)
+        {
+            __m128i low  = quantizePair(_mm_loadu_pd(pSrc), numOutOfRange);
+            __m128i high = quantizePair(_mm_loadu_pd(pSrc + 2), numOutOfRange);
+            return _mm_unpacklo_epi64(low, high);
+        }
+
+        static __m128i quantizeLanes(const float* pSrc, size_t& numOutOfRange)
+        {
+            __m128  values = _mm_loadu_ps(pSrc);
+            __m128i low    = quantizePair(_mm_cvtps_pd(values), numOutOfRange);
+            __m128i high   = quantizePair(_mm_cvtps_pd(_mm_movehl_ps(values, values)), numOutOfRange);
+            return _mm_unpacklo_epi64(low, high);
+        }
+
+        static void dequantizeLanes(__m128i low, __m128i high, double* pDest)
+        {
+            const __m128d stepSize = _mm_set1_pd(StepSize);
+            _mm_storeu_pd(pDest, _mm_mul_pd(_mm_cvtepi32_pd(low), stepSize));
+            _mm_storeu_pd(pDest + 2, _mm_mul_pd(_mm_cvtepi32_pd(_mm_unpackhi_epi64(low, low)), stepSize));
+            _mm_storeu_pd(pDest + 4, _mm_mul_pd(_mm_cvtepi32_pd(high), stepSize));
+            _mm_storeu_pd(pDest + 6, _mm_mul_pd(_mm_cvtepi32_pd(_mm_unpackhi_epi64(high, high)), stepSize));
+        }
+
+        static void dequantizeLanes(__m128i low, __m128i high, float* pDest)
+        {
+            const __m128 stepSize = _mm_set1_ps(static_cast<float>(StepSize));
+            _mm_storeu_ps(pDest, _mm_mul_ps(_mm_cvtepi32_ps(low), stepSize));
+            _mm_storeu_ps(pDest + 4, _mm_mul_ps(_mm_cvtepi32_ps(high), stepSize));
+        }
+#endif
+
+        /**
+         * Store 8 int32 values that are already within the raw range as BASE_TYPE.
+         */
+        static void storeNarrowed(BASE_TYPE* pDest, __m128i low, __m128i high)
+        {
+            if constexpr (sizeof(BASE_TYPE) == 4) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(pDest), low);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(pDest + 4), high);
+            } else if constexpr (sizeof(BASE_TYPE) == 2) {
+                __m128i words;
+                if constexpr (std::is_signed<BASE_TYPE>::value) {
+                    words = _mm_packs_epi32(low, high);
+                } else {
+                    // SSE2 has no unsigned 32 to 16 bit pack, shift into the signed range and back.
+                    const __m128i bias = _mm_set1_epi32(0x8000);
+                    words              = _mm_packs_epi32(_mm_sub_epi32(low, bias), _mm_sub_epi32(high, bias));
+                    words              = _mm_xor_si128(words, _mm_set1_epi16(static_cast<short>(0x8000)));
+                }
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(pDest), words);
+            } else {
+                __m128i words = _mm_packs_epi32(low, high);
+                __m128i bytes = std::is_signed<BASE_TYPE>::value ? _mm_packs_epi16(words, words)
+                                                                 : _mm_packus_epi16(words, words);
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(pDest), bytes);
+            }
+        }
+
+        /**
+         * Load 8 raw values widened to int32.
+         */
+        static void loadWidened(const BASE_TYPE* pSrc, __m128i& low, __m128i& high)
+        {
+            const __m128i zero = _mm_setzero_si128();
+            if constexpr (sizeof(BASE_TYPE) == 4) {
+                low  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc));
+                high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + 4));
+            } else if constexpr (sizeof(BASE_TYPE) == 2) {
+                __m128i words = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc));
+                if constexpr (std::is_signed<BASE_TYPE>::value) {
+                    low  = _mm_srai_epi32(_mm_unpacklo_epi16(words, words), 16);
+                    high = _mm_srai_epi32(_mm_unpackhi_epi16(words, words), 16);
+                } else {
+                    low  = _mm_unpacklo_epi16(words, zero);
+                    high = _mm_unpackhi_epi16(words, zero);
+                }
+            } else {
+                __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(pSrc));
+                if constexpr (std::is_signed<BASE_TYPE>::value) {
+                    __m128i words = _mm_srai_epi16(_mm_unpacklo_epi8(bytes, bytes), 8);
+                    low           = _mm_srai_epi32(_mm_unpacklo_epi16(words, words), 16);
+                    high          = _mm_srai_epi32(_mm_unpackhi_epi16(words, words), 16);
+                } else {
+                    __m128i words = _mm_unpacklo_epi8(bytes, zero);
+                    low           = _mm_unpacklo_epi16(words, zero);
+                    high          = _mm_unpackhi_epi16(words, zero);
+                }
+            }
+        }
+#endif
+    };
+} // namespace Shared
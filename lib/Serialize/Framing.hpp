@@ -0,0 +1,393 @@
+#pragma once
+
+#include "SerializeDeserializeNum.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace Shared {
+    /**
+     * Consistent Overhead Byte Stuffing. Frames contain no zero bytes and are terminated by a zero byte,
+     * the overhead is one byte per 254 payload bytes.
+     */
+    struct CobsFraming
+    {
+        static constexpr unsigned char Delimiter = 0x00;
+
+        /**
+         * @return Largest encoded size of size payload bytes, including the delimiter.
+         */
+        static constexpr size_t GetMaxEncodedSize(size_t size) { return size + size / 254 + 2; }
+
+        /**
+         * Append the encoding of payload followed by trailer, and the delimiter, to dest.
+         */
+        static void Encode(std::span<const std::byte> payload, std::span<const std::byte> trailer,
+                           std::vector<std::byte>& dest)
+        {
+            size_t codeLoc = dest.size();
+            size_t runLength{0};
+            dest.push_back(std::byte(0));
+
+            // Each block is a code byte (block length + 1) followed by up to 254 non zero bytes. Blocks shorter
+            // than 254 bytes stand for the data followed by a zero.
+            auto append = [&](std::span<const std::byte> bytes) {
+                while (!bytes.empty())
+                {
+                    size_t      limit = std::min(bytes.size(), 254 - runLength);
+                    const void* pZero = std::memchr(bytes.data(), 0, limit);
+                    size_t      size  = pZero != nullptr ? static_cast<const std::byte*>(pZero) - bytes.data() : limit;
+
+                    dest.insert(dest.end(), bytes.begin(), bytes.begin() + size);
+                    runLength += size;
+                    bytes = bytes.subspan(pZero != nullptr ? size + 1 : size);
+                    if (pZero != nullptr || runLength == 254)
+                    {
+                        dest[codeLoc] = static_cast<std::byte>(runLength + 1);
+                        codeLoc       = dest.size();
+                        runLength     = 0;
+                        dest.push_back(std::byte(0));
+                    }
+                }
+            };
+            append(payload);
+            append(trailer);
+
+            dest[codeLoc] = static_cast<std::byte>(runLength + 1);
+            dest.push_back(std::byte(Delimiter));
+        }
+
+        /**
+         * Decode a frame in place. The decoded frame is never longer than the encoded one.
+         * @param frame: Encoded frame without the delimiter.
+         * @param size: Set to the decoded size, the decoded bytes start at frame.data().
+         * @return false if the frame is malformed.
+         */
+        static bool Decode(std::span<std::byte> frame, size_t& size)
+        {
+            size_t readLoc{0};
+            size_t writeLoc{0};
+            while (readLoc < frame.size())
+            {
+                size_t code = static_cast<size_t>(frame[readLoc++]);
+                if (code == 0 || code - 1 > frame.size() - readLoc)
+                    return false;
+
+                std::memmove(frame.data() + writeLoc, frame.data() + readLoc, code - 1);
+                readLoc += code - 1;
+                writeLoc += code - 1;
+                if (code != 0xFF && readLoc < frame.size())
+                {
+                    frame[writeLoc++] = std::byte(0);
+                }
+            }
+
+            size = writeLoc;
+            return true;
+        }
+    };
+
+    /**
+     * Serial Line IP framing (RFC 1055). END and ESC bytes in the payload are escaped, frames are
+     * terminated by END. Payloads without END/ESC bytes are sent and decoded unchanged.
+     */
+    struct SlipFraming
+    {
+        static constexpr unsigned char Delimiter = 0xC0;
+        static constexpr unsigned char Escape    = 0xDB;
+        static constexpr unsigned char EscapeEnd = 0xDC;
+        static constexpr unsigned char EscapeEsc = 0xDD;
+
+        static constexpr size_t GetMaxEncodedSize(size_t size) { return 2 * size + 1; }
+
+        static void Encode(std::span<const std::byte> payload, std::span<const std::byte> trailer,
+                           std::vector<std::byte>& dest)
+        {
+            auto append = [&](std::span<const std::byte> bytes) {
+                auto begin = bytes.begin();
+                while (begin != bytes.end())
+                {
+                    auto special = std::find_if(begin, bytes.end(), [](std::byte value) {
+                        return value == std::byte(Delimiter) || value == std::byte(Escape);
+                    });
+                    dest.insert(dest.end(), begin, special);
+                    if (special == bytes.end())
+                        break;
+
+                    dest.push_back(std::byte(Escape));
+                    dest.push_back(std::byte(*special == std::byte(Delimiter) ? EscapeEnd : EscapeEsc));
+                    begin = special + 1;
+                }
+            };
+            append(payload);
+            append(trailer);
+
+            dest.push_back(std::byte(Delimiter));
+        }
+
+        /**
+         * Decode a frame in place, see CobsFraming::Decode().
+         */
+        static bool Decode(std::span<std::byte> frame, size_t& size)
+        {
+            const void* pEscape = std::memchr(frame.data(), Escape, frame.size());
+            if (pEscape == nullptr)
+            {
+                size = frame.size();
+                return true;
+            }
+
+            size_t writeLoc = static_cast<const std::byte*>(pEscape) - frame.data();
+            for (size_t readLoc = writeLoc; readLoc < frame.size(); ++readLoc)
+            {
+                std::byte value = frame[readLoc];
+                if (value == std::byte(Escape))
+                {
+                    if (++readLoc == frame.size())
+                        return false;
+
+                    if (frame[readLoc] == std::byte(EscapeEnd))
+                    {
+                        value = std::byte(Delimiter);
+                    }
+                    else if (frame[readLoc] == std::byte(EscapeEsc))
+                    {
+                        value = std::byte(Escape);
+                    }
+                    else
+                    {
+                        return false;
+                    }
+                }
+                frame[writeLoc++] = value;
+            }
+
+            size = writeLoc;
+            return true;
+        }
+    };
+
+    /**
+     * Optional CRC appended to framed payloads, CRC_HELPER is a CRCHelper instantiation or void for none.
+     * The CRC is computed over the payload and stored little endian.
+     */
+    template <class CRC_HELPER>
+    struct FrameCheck
+    {
+        typedef decltype(CRC_HELPER::CalculateCRCViaTable(static_cast<const unsigned char*>(nullptr),
+                                                          static_cast<const unsigned char*>(nullptr))) crcType;
+
+        static constexpr size_t Size = sizeof(crcType);
+
+        static crcType Calculate(std::span<const std::byte> payload)
+        {
+            const unsigned char* pBegin = reinterpret_cast<const unsigned char*>(payload.data());
+            return CRC_HELPER::CalculateCRCViaTable(pBegin, pBegin + payload.size());
+        }
+
+        static void Write(std::span<const std::byte> payload, std::byte* pDest)
+        {
+            SerializeArithmaticType<crcType>(Calculate(payload), pDest);
+        }
+
+        static bool Validate(std::span<const std::byte> payload, const std::byte* pCRC)
+        {
+            return DeSerializeArithmaticType<crcType>(pCRC) == Calculate(payload);
+        }
+    };
+
+    template <>
+    struct FrameCheck<void>
+    {
+        static constexpr size_t Size = 0;
+
+        static void Write(std::span<const std::byte>, std::byte*) {}
+        static bool Validate(std::span<const std::byte>, const std::byte*) { return true; }
+    };
+
+    /**
+     * Append one frame holding payload, followed by its CRC if CRC_HELPER is not void, to dest.
+     * @tparam FRAMING: CobsFraming or SlipFraming
+     */
+    template <class FRAMING, class CRC_HELPER = void>
+    static void EncodeFrame(std::span<const std::byte> payload, std::vector<std::byte>& dest)
+    {
+        std::byte trailer[std::max<size_t>(FrameCheck<CRC_HELPER>::Size, 1)];
+        FrameCheck<CRC_HELPER>::Write(payload, trailer);
+
+        dest.reserve(dest.size() + FRAMING::GetMaxEncodedSize(payload.size() + FrameCheck<CRC_HELPER>::Size));
+        FRAMING::Encode(payload, std::span<const std::byte>(trailer, FrameCheck<CRC_HELPER>::Size), dest);
+    }
+
+    /**
+     * Default limit for the encoded size of frames accepted by StreamDeframer.
+     */
+    constexpr size_t DefaultMaxFrameSize = 64 * 1024;
+
+    /**
+     * Incremental deframer splitting a byte stream, received in arbitrary chunks, into decoded frames.
+     * Delimiters are located with memchr(). Frames that lie completely inside one chunk passed to Consume()
+     * are decoded in place and passed on without copying, only frames spanning chunks are assembled in an
+     * internal buffer. ConsumeCopy() accepts read-only chunks and copies every frame. Malformed, oversized
+     * and (with CRC_HELPER) corrupt frames are dropped and counted, so the deframer resynchronizes on the next
+     * delimiter. Empty frames are ignored.
+     * The class is not thread safe.
+     * @tparam FRAMING: CobsFraming or SlipFraming
+     * @tparam CRC_HELPER: CRCHelper instantiation frames are validated with, or void
+     */
+    template <class FRAMING, class CRC_HELPER = void>
+    class StreamDeframer {
+      public:
+        /**
+         * Called with each decoded payload, without the CRC. The span is only valid during the call.
+         */
+        typedef std::function<void(std::span<const std::byte>)> frameHandlerType;
+
+        /**
+         * @param handler: Receives the decoded frames.
+         * @param maxFrameSize: Frames with a longer encoding are dropped.
+         */
+        StreamDeframer(frameHandlerType handler, size_t maxFrameSize = DefaultMaxFrameSize)
+            : m_Handler(std::move(handler))
+            , m_MaxFrameSize(maxFrameSize)
+            , m_IsOversized(false)
+            , m_NumFrames(0)
+            , m_NumDropped(0)
+        {
+        }
+
+        /**
+         * Process a chunk. Frames inside the chunk are decoded in place, so its contents are modified.
+         */
+        void Consume(std::span<std::byte> chunk)
+        {
+            while (!chunk.empty())
+            {
+                const void* pDelimiter = std::memchr(chunk.data(), FRAMING::Delimiter, chunk.size());
+                if (pDelimiter == nullptr)
+                {
+                    appendPartial(chunk);
+                    return;
+                }
+
+                size_t size = static_cast<const std::byte*>(pDelimiter) - chunk.data();
+                if (m_Partial.empty() && !m_IsOversized)
+                {
+                    processFrame(chunk.first(size));
+                }
+                else
+                {
+                    appendPartial(chunk.first(size));
+                    finishPartial();
+                }
+                chunk = chunk.subspan(size + 1);
+            }
+        }
+
+        /**
+         * Process a read-only chunk. Every frame is copied to the internal buffer before decoding.
+         */
+        void ConsumeCopy(std::span<const std::byte> chunk)
+        {
+            while (!chunk.empty())
+            {
+                const void* pDelimiter = std::memchr(chunk.data(), FRAMING::Delimiter, chunk.size());
+                size_t      size = pDelimiter != nullptr ? static_cast<const std::byte*>(pDelimiter) - chunk.data()
+                                                         : chunk.size();
+
+                appendPartial(chunk.first(size));
+                if (pDelimiter == nullptr)
+                    return;
+
+                finishPartial();
+                chunk = chunk.subspan(size + 1);
+            }
+        }
+
+        /**
+         * Discard a partially received frame, e.g. after the link was reset.
+         */
+        void Reset()
+        {
+            m_Partial.clear();
+            m_IsOversized = false;
+        }
+
+        /**
+         * @return Number of frames passed to the handler.
+         */
+        size_t GetFrameCount() const { return m_NumFrames; }
+
+        /**
+         * @return Number of malformed, oversized or corrupt frames dropped.
+         */
+        size_t GetDroppedFrameCount() const { return m_NumDropped; }
+
+      private:
+        void appendPartial(std::span<const std::byte> bytes)
+        {
+            if (m_IsOversized)
+                return;
+
+            if (bytes.size() > m_MaxFrameSize - m_Partial.size())
+            {
+                // Stop buffering, the frame is dropped once its delimiter arrives.
+                m_Partial.clear();
+                m_IsOversized = true;
+                return;
+            }
+            m_Partial.insert(m_Partial.end(), bytes.begin(), bytes.end());
+        }
+
+        void finishPartial()
+        {
+            if (m_IsOversized)
+            {
+                ++m_NumDropped;
+            }
+            else
+            {
+                processFrame(m_Partial);
+            }
+            Reset();
+        }
+
+        void processFrame(std::span<std::byte> frame)
+        {
+            if (frame.empty())
+                return;
+
+            size_t size{0};
+            if (frame.size() > m_MaxFrameSize || !FRAMING::Decode(frame, size) || size < FrameCheck<CRC_HELPER>::Size)
+            {
+                ++m_NumDropped;
+                return;
+            }
+
+            size_t payloadSize = size - FrameCheck<CRC_HELPER>::Size;
+            std::span<const std::byte> payload(frame.data(), payloadSize);
+            if (!FrameCheck<CRC_HELPER>::Validate(payload, frame.data() + payloadSize))
+            {
+                ++m_NumDropped;
+                return;
+            }
+
+            ++m_NumFrames;
+            m_Handler(payload);
+        }
+
+        frameHandlerType       m_Handler;
+        size_t                 m_MaxFrameSize;
+        std::vector<std::byte> m_Partial;
+        bool                   m_IsOversized;
+        size_t                 m_NumFrames;
+        size_t                 m_NumDropped;
+    };
+} // namespace Shared
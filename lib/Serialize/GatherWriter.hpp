@@ -0,0 +1,294 @@
+#pragma once
+
+#include "BinaryWriter.hpp"
+#include "SerializeDeserializeNum.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <climits>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace Shared {
+    /**
+     * Default size from which GatherWriter references byte ranges instead of copying them.
+     */
+    constexpr size_t DefaultGatherReferenceSize = 256;
+
+    /**
+     * Binary writer producing a scatter-gather list instead of one contiguous buffer.
+     * Small fields are serialized into an internal buffer while large byte ranges are recorded by reference,
+     * so a header plus a large existing payload can be sent with a single writev()/sendmsg() call without
+     * copying the payload. The wire format matches BinaryWriter.
+     * Referenced ranges must stay valid and unchanged until the output has been sent.
+     * The class is not thread safe.
+     * @tparam UseExceptions: Passed to the BinaryWriter used for inline data
+     * @tparam endianess: Byte order used for numeric values and fixed size array lengths
+     */
+    template <bool UseExceptions = true, Endianess endianess = Endianess::LittleEndian>
+    class GatherWriter {
+        typedef BinaryWriter<std::vector<unsigned char>::iterator, UseExceptions, endianess> inlineWriterType;
+
+      public:
+        /**
+         * @param referenceSize: Byte ranges of at least this size are referenced instead of copied.
+         * @param initialCapacity: Number of bytes to reserve for inline data.
+         */
+        GatherWriter(size_t referenceSize = DefaultGatherReferenceSize, size_t initialCapacity = 0)
+            : m_ReferenceSize(referenceSize)
+            , m_Inline(initialCapacity)
+            , m_InlineSize(0)
+            , m_Size(0)
+        {
+        }
+
+        /**
+         * Remove all segments, keeping the inline buffer capacity.
+         */
+        void Clear()
+        {
+            m_Inline.Clear();
+            m_Segments.clear();
+            m_InlineSize = 0;
+            m_Size       = 0;
+        }
+
+        /**
+         * @return Total number of bytes in all segments.
+         */
+        size_t GetSize() const { return m_Size; }
+
+        /**
+         * @return Number of segments, at most one more than twice the number of referenced ranges.
+         */
+        size_t GetSegmentCount() const { return m_Segments.size(); }
+
+        template <class T>
+        void WriteNum(T value)
+        {
+            m_Inline.WriteNum(value);
+            appendInline();
+        }
+
+        template <class T>
+        void WriteVarint(T value)
+        {
+            m_Inline.WriteVarint(value);
+            appendInline();
+        }
+
+        template <class w_INPUT_IT>
+        void WriteVarintArray(w_INPUT_IT begin, w_INPUT_IT end)
+        {
+            m_Inline.WriteVarintArray(begin, end);
+            appendInline();
+        }
+
+        template <class T>
+        void WriteStruct(const T& value)
+        {
+            m_Inline.WriteStruct(value);
+            appendInline();
+        }
+
+        /**
+         * Write an array of numeric values. Large contiguous arrays whose in-memory representation already
+         * matches the wire format are referenced, everything else is copied.
+         */
+        template <class w_INPUT_IT>
+        void WriteArrayNum(w_INPUT_IT begin, w_INPUT_IT end, LengthPrefix prefix = LengthPrefix::Fixed)
+        {
+            typedef std::remove_cv_t<typename std::iterator_traits<w_INPUT_IT>::value_type> T;
+
+            if constexpr (std::contiguous_iterator<w_INPUT_IT> && IsNativeEndianess<endianess>())
+            {
+                size_t arraySize = std::distance(begin, end);
+                if (arraySize * sizeof(T) >= m_ReferenceSize)
+                {
+                    if (prefix == LengthPrefix::Fixed)
+                    {
+                        WriteNum<size_t>(arraySize);
+                    }
+                    else
+                    {
+                        WriteVarint<size_t>(arraySize);
+                    }
+                    appendReference(std::as_bytes(std::span<const T>(std::to_address(begin), arraySize)));
+                    return;
+                }
+            }
+
+            m_Inline.WriteArrayNum(begin, end, prefix);
+            appendInline();
+        }
+
+        /**
+         * Write raw bytes, referencing them if they are at least the reference size.
+         */
+        void WriteBytes(std::span<const std::byte> bytes)
+        {
+            if (bytes.size() >= m_ReferenceSize)
+            {
+                appendReference(bytes);
+            }
+            else
+            {
+                m_Inline.WriteBytes(bytes);
+                appendInline();
+            }
+        }
+
+        /**
+         * Reference raw bytes regardless of their size.
+         */
+        void WriteBytesByReference(std::span<const std::byte> bytes) { appendReference(bytes); }
+
+        /**
+         * @return Segments in output order. Only valid until the next write.
+         */
+        std::vector<std::span<const std::byte>> GetSegments() const
+        {
+            std::vector<std::span<const std::byte>> segments;
+            segments.reserve(m_Segments.size());
+            forEachSegment([&](const std::byte* pData, size_t size) { segments.emplace_back(pData, size); });
+
+            return segments;
+        }
+
+        /**
+         * Copy all segments into one contiguous buffer.
+         */
+        std::vector<std::byte> Flatten() const
+        {
+            std::vector<std::byte> bytes;
+            bytes.reserve(m_Size);
+            forEachSegment(
+                [&](const std::byte* pData, size_t size) { bytes.insert(bytes.end(), pData, pData + size); });
+
+            return bytes;
+        }
+
+#if defined(__unix__) || defined(__APPLE__)
+        /**
+         * @return iovec list for writev()/sendmsg(). Only valid until the next write.
+         */
+        std::vector<iovec> GetIovecs() const
+        {
+            std::vector<iovec> iovecs;
+            iovecs.reserve(m_Segments.size());
+            forEachSegment([&](const std::byte* pData, size_t size) {
+                iovecs.push_back(iovec{const_cast<std::byte*>(pData), size});
+            });
+
+            return iovecs;
+        }
+
+        /**
+         * Write all segments to a file descriptor with writev(), retrying partial writes and interrupted
+         * calls and splitting lists longer than IOV_MAX.
+         * @return false if writev() failed, errno is left set.
+         */
+        bool WriteTo(int fd) const
+        {
+            std::vector<iovec> iovecs = GetIovecs();
+
+            size_t first{0};
+            while (first < iovecs.size())
+            {
+                int     count      = static_cast<int>(std::min<size_t>(iovecs.size() - first, IOV_MAX));
+                ssize_t numWritten = ::writev(fd, iovecs.data() + first, count);
+                if (numWritten < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+
+                    return false;
+                }
+
+                // Skip fully written segments and trim a partially written one.
+                size_t remaining = static_cast<size_t>(numWritten);
+                while (first < iovecs.size() && remaining >= iovecs[first].iov_len)
+                {
+                    remaining -= iovecs[first].iov_len;
+                    ++first;
+                }
+                if (remaining > 0)
+                {
+                    iovecs[first].iov_base = static_cast<char*>(iovecs[first].iov_base) + remaining;
+                    iovecs[first].iov_len -= remaining;
+                }
+            }
+
+            return true;
+        }
+#endif
+
+      private:
+        /**
+         * Referenced segments store the range, inline segments store an offset into the inline buffer so
+         * they survive the inline buffer growing.
+         */
+        struct Segment
+        {
+            const std::byte* pData;
+            size_t           offset;
+            size_t           size;
+        };
+
+        /**
+         * Account for bytes just written to the inline buffer, extending the last segment if it is inline.
+         */
+        void appendInline()
+        {
+            size_t inlineSize = m_Inline.GetSize();
+            size_t size       = inlineSize - m_InlineSize;
+            if (size == 0)
+                return;
+
+            if (!m_Segments.empty() && m_Segments.back().pData == nullptr)
+            {
+                m_Segments.back().size += size;
+            }
+            else
+            {
+                m_Segments.push_back(Segment{nullptr, m_InlineSize, size});
+            }
+            m_InlineSize = inlineSize;
+            m_Size += size;
+        }
+
+        void appendReference(std::span<const std::byte> bytes)
+        {
+            if (bytes.empty())
+                return;
+
+            m_Segments.push_back(Segment{bytes.data(), 0, bytes.size()});
+            m_Size += bytes.size();
+        }
+
+        template <class FUNC>
+        void forEachSegment(FUNC&& func) const
+        {
+            const std::byte* pInline = reinterpret_cast<const std::byte*>(std::to_address(m_Inline.GetBegin()));
+            for (const Segment& segment : m_Segments)
+            {
+                func(segment.pData != nullptr ? segment.pData : pInline + segment.offset, segment.size);
+            }
+        }
+
+        size_t               m_ReferenceSize;
+        inlineWriterType     m_Inline;
+        std::vector<Segment> m_Segments;
+        size_t               m_InlineSize;
+        size_t               m_Size;
+    };
+} // namespace Shared
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace Shared
+{
+    /**
+     * Portable 128 bit two's complement integer for compilers without __int128.
+     * Provides the subset used for FixedPoint intermediates: +, -, *, / (truncating towards zero), shifts by less
+     * than 128 bits, comparisons and explicit conversion to built-in integers, which keeps the low bits.
+     */
+    template<bool IS_SIGNED>
+    class PortableInt128
+    {
+      public:
+        constexpr PortableInt128()
+            : m_Low(0)
+            , m_High(0)
+        {
+        }
+
+        template<class T>
+            requires std::is_integral_v<T>
+        constexpr PortableInt128(T value)
+            : m_Low(static_cast<uint64_t>(value))
+            , m_High((std::is_signed_v<T> && value < 0) ? ~uint64_t(0) : 0)
+        {
+        }
+
+        template<class T>
+            requires std::is_integral_v<T>
+        explicit constexpr operator T() const
+        {
+            return static_cast<T>(m_Low);
+        }
+
+        constexpr uint64_t GetLow() const { return m_Low; }
+        constexpr uint64_t GetHigh() const { return m_High; }
+
+        friend constexpr PortableInt128 operator+(PortableInt128 lhs, PortableInt128 rhs)
+        {
+            uint64_t low = lhs.m_Low + rhs.m_Low;
+            return PortableInt128(low, lhs.m_High + rhs.m_High + (low < lhs.m_Low ? 1 : 0));
+        }
+
+        friend constexpr PortableInt128 operator-(PortableInt128 lhs, PortableInt128 rhs)
+        {
+            return PortableInt128(lhs.m_Low - rhs.m_Low, lhs.m_High - rhs.m_High - (lhs.m_Low < rhs.m_Low ? 1 : 0));
+        }
+
+        constexpr PortableInt128 operator-() const { return PortableInt128() - *this; }
+
+        /**
+         * Low 128 bits of the product, which is the same for signed and unsigned values.
+         */
+        friend constexpr PortableInt128 operator*(PortableInt128 lhs, PortableInt128 rhs)
+        {
+            PortableInt128 product = multiply64(lhs.m_Low, rhs.m_Low);
+            product.m_High += lhs.m_Low * rhs.m_High + lhs.m_High * rhs.m_Low;
+            return product;
+        }
+
+        friend constexpr PortableInt128 operator/(PortableInt128 lhs, PortableInt128 rhs)
+        {
+            if constexpr (IS_SIGNED) {
+                bool           negative = lhs.isNegative() != rhs.isNegative();
+                PortableInt128 quotient =
+                    divideMagnitudes(lhs.isNegative() ? -lhs : lhs, rhs.isNegative() ? -rhs : rhs);
+                return negative ? -quotient : quotient;
+            }
+            return divideMagnitudes(lhs, rhs);
+        }
+
+        friend constexpr PortableInt128 operator<<(PortableInt128 value, size_t shift)
+        {
+            if (shift == 0) {
+                return value;
+            }
+            if (shift >= 64) {
+                return PortableInt128(0, value.m_Low << (shift - 64));
+            }
+            return PortableInt128(value.m_Low << shift, (value.m_High << shift) | (value.m_Low >> (64 - shift)));
+        }
+
+        /**
+         * Arithmetic shift for signed values, logical shift for unsigned values.
+         */
+        friend constexpr PortableInt128 operator>>(PortableInt128 value, size_t shift)
+        {
+            uint64_t fill = value.isNegative() ? ~uint64_t(0) : 0;
+            if (shift == 0) {
+                return value;
+            }
+            if (shift >= 64) {
+                uint64_t low = (shift == 64) ? value.m_High : (value.m_High >> (shift - 64)) | (fill << (128 - shift));
+                return PortableInt128(low, fill);
+            }
+            return PortableInt128((value.m_Low >> shift) | (value.m_High << (64 - shift)),
+                                  (value.m_High >> shift) | (fill << (64 - shift)));
+        }
+
+        constexpr PortableInt128& operator+=(PortableInt128 other) { return *this = *this + other; }
+        constexpr PortableInt128& operator-=(PortableInt128 other) { return *this = *this - other; }
+
+        friend constexpr bool operator==(PortableInt128 lhs, PortableInt128 rhs)
+        {
+            return lhs.m_Low == rhs.m_Low && lhs.m_High == rhs.m_High;
+        }
+
+        friend constexpr std::strong_ordering operator<=>(PortableInt128 lhs, PortableInt128 rhs)
+        {
+            if (lhs.m_High != rhs.m_High) {
+                if constexpr (IS_SIGNED) {
+                    return static_cast<int64_t>(lhs.m_High) <=> static_cast<int64_t>(rhs.m_High);
+                }
+                return lhs.m_High <=> rhs.m_High;
+            }
+            return lhs.m_Low <=> rhs.m_Low;
+        }
+
+      private:
+        constexpr PortableInt128(uint64_t low, uint64_t high)
+            : m_Low(low)
+            , m_High(high)
+        {
+        }
+
+        constexpr bool isNegative() const { return IS_SIGNED && (m_High >> 63) != 0; }
+
+        static constexpr PortableInt128 multiply64(uint64_t lhs, uint64_t rhs)
+        {
+            uint64_t lhsLow  = lhs & 0xFFFFFFFF;
+            uint64_t lhsHigh = lhs >> 32;
+            uint64_t rhsLow  = rhs & 0xFFFFFFFF;
+            uint64_t rhsHigh = rhs >> 32;
+
+            uint64_t lowLow   = lhsLow * rhsLow;
+            uint64_t highLow  = lhsHigh * rhsLow;
+            uint64_t lowHigh  = lhsLow * rhsHigh;
+            uint64_t highHigh = lhsHigh * rhsHigh;
+
+            uint64_t middle = (lowLow >> 32) + (highLow & 0xFFFFFFFF) + (lowHigh & 0xFFFFFFFF);
+            return PortableInt128((middle << 32) | (lowLow & 0xFFFFFFFF),
+                                  highHigh + (highLow >> 32) + (lowHigh >> 32) + (middle >> 32));
+        }
+
+        /**
+         * Unsigned long division, one quotient bit per step.
+         */
+        static constexpr PortableInt128 divideMagnitudes(PortableInt128 dividend, PortableInt128 divisor)
+        {
+            if (dividend.m_High == 0 && divisor.m_High == 0) {
+                return PortableInt128(dividend.m_Low / divisor.m_Low, 0);
+            }
+
+            PortableInt128<false> remainder;
+            PortableInt128<false> quotient;
+            PortableInt128<false> unsignedDivisor(divisor.m_Low, divisor.m_High);
+            for (int bit = 127; bit >= 0; --bit) {
+                uint64_t word = (bit >= 64) ? dividend.m_High : dividend.m_Low;
+                remainder     = (remainder << 1) + PortableInt128<false>((word >> (bit % 64)) & 1, 0);
+                quotient      = quotient << 1;
+                if (remainder >= unsignedDivisor) {
+                    remainder -= unsignedDivisor;
+                    quotient += PortableInt128<false>(1, 0);
+                }
+            }
+            return PortableInt128(quotient.m_Low, quotient.m_High);
+        }
+
+        template<bool>
+        friend class PortableInt128;
+
+        uint64_t m_Low;
+        uint64_t m_High;
+    };
+
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef __int128 Int128;
+    __extension__ typedef unsigned __int128 UInt128;
+#else
+    typedef PortableInt128<true>  Int128;
+    typedef PortableInt128<false> UInt128;
+#endif
+} // namespace Shared
@@ -0,0 +1,522 @@
+#pragma once
+
+#include "SerializeDeserializeNum.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace Shared {
+    /**
+     * LZ77 block compression using the LZ4 block format.
+     * A block is a list of sequences, each a token byte (literal length in the high nibble, match length - 4
+     * in the low nibble, 15 meaning more length bytes follow), the literals, a 2 byte little endian match
+     * offset and the extra match length bytes. The last sequence only has literals. Matches are at least 4
+     * bytes, at most 65535 bytes back, and the last 5 bytes of a block are always literals, so blocks can
+     * also be read by standard LZ4 block decoders.
+     */
+    constexpr size_t LZMinMatch     = 4;
+    constexpr size_t LZMaxOffset    = 65535;
+    constexpr size_t LZLastLiterals = 5;
+    constexpr size_t LZMatchLimit   = 12; ///< No match may start in the last LZMatchLimit bytes
+
+    /**
+     * @return Compressed size of a block of size bytes in the worst case (incompressible data).
+     */
+    constexpr size_t LZGetMaxCompressedSize(size_t size) { return size + size / 255 + 16; }
+
+    /**
+     * Block compressor using hash chains to find the longest match among recent candidates.
+     * The hash tables are reused across blocks, so keep one compressor per thread for repeated use.
+     * Decompression cost does not depend on the chain length, longer chains only trade compression speed
+     * for ratio.
+     */
+    class LZBlockCompressor {
+      public:
+        static constexpr size_t DefaultMaxChainLength = 16;
+
+        /**
+         * @param maxChainLength: Number of earlier positions with the same hash tried per position.
+         */
+        explicit LZBlockCompressor(size_t maxChainLength = DefaultMaxChainLength)
+            : m_MaxChainLength(std::max<size_t>(maxChainLength, 1))
+            , m_Head(HashSize)
+            , m_Chain(WindowSize)
+        {
+        }
+
+        /**
+         * Compress a block.
+         * @param dest: Output, LZGetMaxCompressedSize(src.size()) bytes are always enough.
+         * @return Compressed size, or 0 if dest is too small.
+         */
+        size_t Compress(std::span<const std::byte> src, std::span<std::byte> dest)
+        {
+            const unsigned char* pSrc = reinterpret_cast<const unsigned char*>(src.data());
+            const size_t         size = src.size();
+
+            std::fill(m_Head.begin(), m_Head.end(), 0);
+            m_pDest    = reinterpret_cast<unsigned char*>(dest.data());
+            m_DestSize = dest.size();
+            m_DestLoc  = 0;
+
+            size_t anchor{0};
+            size_t pos{0};
+            if (size >= LZMatchLimit + 1)
+            {
+                const size_t matchEnd   = size - LZLastLiterals;
+                const size_t matchStart = size - LZMatchLimit;
+                while (pos < matchStart)
+                {
+                    size_t matchPos{0};
+                    size_t matchLength = findMatch(pSrc, pos, matchEnd, matchPos);
+                    if (matchLength == 0)
+                    {
+                        insert(pSrc, pos);
+                        ++pos;
+                        continue;
+                    }
+
+                    if (!writeSequence(pSrc + anchor, pos - anchor, pos - matchPos, matchLength))
+                        return 0;
+
+                    // Index the positions covered by the match so later data can refer to them.
+                    size_t matchFinish = pos + matchLength;
+                    for (; pos < matchFinish && pos < matchStart; ++pos)
+                    {
+                        insert(pSrc, pos);
+                    }
+                    pos    = matchFinish;
+                    anchor = pos;
+                }
+            }
+
+            if (!writeLiterals(pSrc + anchor, size - anchor))
+                return 0;
+
+            return m_DestLoc;
+        }
+
+        /**
+         * Compress a block into a new buffer.
+         */
+        std::vector<std::byte> Compress(std::span<const std::byte> src)
+        {
+            std::vector<std::byte> compressed(LZGetMaxCompressedSize(src.size()));
+            compressed.resize(Compress(src, compressed));
+            return compressed;
+        }
+
+      private:
+        static constexpr size_t HashBits   = 15;
+        static constexpr size_t HashSize   = size_t(1) << HashBits;
+        static constexpr size_t WindowSize = 65536;
+
+        static uint32_t read32(const unsigned char* p)
+        {
+            uint32_t value;
+            std::memcpy(&value, p, sizeof(value));
+            return value;
+        }
+
+        static size_t hash(const unsigned char* p) { return (read32(p) * 2654435761u) >> (32 - HashBits); }
+
+        /**
+         * @return Number of equal bytes at pA and pB, comparing up to pLimit - pB bytes.
+         */
+        static size_t commonLength(const unsigned char* pA, const unsigned char* pB, const unsigned char* pLimit)
+        {
+            const unsigned char* pStart = pB;
+            while (pB + sizeof(uint64_t) <= pLimit)
+            {
+                uint64_t a, b;
+                std::memcpy(&a, pA, sizeof(a));
+                std::memcpy(&b, pB, sizeof(b));
+                if (uint64_t diff = a ^ b)
+                {
+                    size_t numBits = std::endian::native == std::endian::little ? std::countr_zero(diff)
+                                                                                 : std::countl_zero(diff);
+                    return static_cast<size_t>(pB - pStart) + numBits / 8;
+                }
+                pA += sizeof(uint64_t);
+                pB += sizeof(uint64_t);
+            }
+            while (pB < pLimit && *pA == *pB)
+            {
+                ++pA;
+                ++pB;
+            }
+            return static_cast<size_t>(pB - pStart);
+        }
+
+        /**
+         * Add a position to the hash chains. Heads store position + 1 so 0 marks an empty bucket, chain
+         * entries store the distance to the previous position with the same hash, 0 if out of range.
+         */
+        void insert(const unsigned char* pSrc, size_t pos)
+        {
+            size_t h        = hash(pSrc + pos);
+            size_t previous = m_Head[h];
+            size_t distance = previous == 0 ? 0 : pos - (previous - 1);
+
+            m_Chain[pos % WindowSize] = distance <= LZMaxOffset ? static_cast<uint16_t>(distance) : 0;
+            m_Head[h]                 = static_cast<uint32_t>(pos + 1);
+        }
+
+        /**
+         * @return Length of the longest match for pos ending before matchEnd, 0 if none.
+         */
+        size_t findMatch(const unsigned char* pSrc, size_t pos, size_t matchEnd, size_t& matchPos) const
+        {
+            size_t previous = m_Head[hash(pSrc + pos)];
+            if (previous == 0)
+                return 0;
+
+            const uint32_t sequence = read32(pSrc + pos);
+            size_t         bestLength{0};
+            size_t         candidate = previous - 1;
+            for (size_t chainLength = 0; chainLength < m_MaxChainLength; ++chainLength)
+            {
+                if (pos - candidate > LZMaxOffset)
+                    break;
+
+                if (read32(pSrc + candidate) == sequence)
+                {
+                    size_t length = LZMinMatch +
+                                    commonLength(pSrc + candidate + LZMinMatch, pSrc + pos + LZMinMatch,
+                                                 pSrc + matchEnd);
+                    if (length > bestLength)
+                    {
+                        bestLength = length;
+                        matchPos   = candidate;
+                    }
+                }
+
+                size_t distance = m_Chain[candidate % WindowSize];
+                if (distance == 0 || distance > candidate)
+                    break;
+                candidate -= distance;
+            }
+
+            return bestLength;
+        }
+
+        bool writeLength(size_t length)
+        {
+            for (; length >= 255; length -= 255)
+            {
+                if (!writeByte(255))
+                    return false;
+            }
+            return writeByte(static_cast<unsigned char>(length));
+        }
+
+        bool writeByte(unsigned char value)
+        {
+            if (m_DestLoc >= m_DestSize)
+                return false;
+
+            m_pDest[m_DestLoc++] = value;
+            return true;
+        }
+
+        bool writeRaw(const unsigned char* pData, size_t size)
+        {
+            if (m_DestSize - m_DestLoc < size)
+                return false;
+
+            if (size != 0)
+            {
+                std::memcpy(m_pDest + m_DestLoc, pData, size);
+            }
+            m_DestLoc += size;
+            return true;
+        }
+
+        bool writeSequence(const unsigned char* pLiterals, size_t numLiterals, size_t offset, size_t matchLength)
+        {
+            size_t matchCode = matchLength - LZMinMatch;
+            if (!writeByte(static_cast<unsigned char>((std::min<size_t>(numLiterals, 15) << 4) |
+                                                      std::min<size_t>(matchCode, 15))))
+                return false;
+            if (numLiterals >= 15 && !writeLength(numLiterals - 15))
+                return false;
+            if (!writeRaw(pLiterals, numLiterals))
+                return false;
+
+            if (!writeByte(static_cast<unsigned char>(offset)) || !writeByte(static_cast<unsigned char>(offset >> 8)))
+                return false;
+
+            return matchCode < 15 || writeLength(matchCode - 15);
+        }
+
+        bool writeLiterals(const unsigned char* pLiterals, size_t numLiterals)
+        {
+            if (!writeByte(static_cast<unsigned char>(std::min<size_t>(numLiterals, 15) << 4)))
+                return false;
+            if (numLiterals >= 15 && !writeLength(numLiterals - 15))
+                return false;
+
+            return writeRaw(pLiterals, numLiterals);
+        }
+
+        size_t                m_MaxChainLength;
+        std::vector<uint32_t> m_Head;
+        std::vector<uint16_t> m_Chain;
+        unsigned char*        m_pDest    = nullptr;
+        size_t                m_DestSize = 0;
+        size_t                m_DestLoc  = 0;
+    };
+
+    /**
+     * Decompress a block written by LZBlockCompressor (or any LZ4 block compressor).
+     * Every length and offset is validated, so corrupt or malicious input cannot read or write out of bounds.
+     * @param dest: Output, must be large enough for the decompressed block.
+     * @param decompressedSize: Set to the decompressed size.
+     * @return false if the block is invalid, truncated or does not fit into dest.
+     */
+    inline bool LZTryDecompressBlock(
+        std::span<const std::byte> src,
+        std::span<std::byte>       dest,
+        size_t&                    decompressedSize)
+    {
+        const unsigned char* pSrc     = reinterpret_cast<const unsigned char*>(src.data());
+        unsigned char*       pDest    = reinterpret_cast<unsigned char*>(dest.data());
+        const size_t         srcSize  = src.size();
+        const size_t         destSize = dest.size();
+
+        // Adds the extension bytes of a length, false if they run past the end of the input.
+        auto readLength = [&](size_t& srcLoc, size_t& length) {
+            unsigned char value;
+            do
+            {
+                if (srcLoc >= srcSize)
+                    return false;
+                value = pSrc[srcLoc++];
+                length += value;
+            } while (value == 255);
+            return true;
+        };
+
+        size_t srcLoc{0};
+        size_t destLoc{0};
+        while (srcLoc < srcSize)
+        {
+            unsigned char token       = pSrc[srcLoc++];
+            size_t        numLiterals = token >> 4;
+            if (numLiterals == 15 && !readLength(srcLoc, numLiterals))
+                return false;
+            if (numLiterals > srcSize - srcLoc || numLiterals > destSize - destLoc)
+                return false;
+
+            if (numLiterals != 0)
+            {
+                std::memcpy(pDest + destLoc, pSrc + srcLoc, numLiterals);
+            }
+            srcLoc += numLiterals;
+            destLoc += numLiterals;
+
+            if (srcLoc == srcSize)
+            {
+                decompressedSize = destLoc;
+                return true;
+            }
+
+            if (srcSize - srcLoc < 2)
+                return false;
+            size_t offset = pSrc[srcLoc] | (static_cast<size_t>(pSrc[srcLoc + 1]) << 8);
+            srcLoc += 2;
+            if (offset == 0 || offset > destLoc)
+                return false;
+
+            size_t matchLength = token & 0x0F;
+            if (matchLength == 15 && !readLength(srcLoc, matchLength))
+                return false;
+            matchLength += LZMinMatch;
+            if (matchLength > destSize - destLoc)
+                return false;
+
+            // Overlapping matches repeat the last offset bytes, copy them in non overlapping chunks.
+            unsigned char* pMatch = pDest + destLoc - offset;
+            if (offset == 1)
+            {
+                std::memset(pDest + destLoc, *pMatch, matchLength);
+            }
+            else if (offset >= matchLength)
+            {
+                std::memcpy(pDest + destLoc, pMatch, matchLength);
+            }
+            else
+            {
+                for (size_t copied = 0; copied < matchLength;)
+                {
+                    size_t chunk = std::min(offset, matchLength - copied);
+                    std::memcpy(pDest + destLoc + copied, pMatch + copied, chunk);
+                    copied += chunk;
+                }
+            }
+            destLoc += matchLength;
+        }
+
+        // Every block ends with a literal only sequence, so running out of input here means truncation.
+        return false;
+    }
+
+    /**
+     * Decompress a block, see LZTryDecompressBlock().
+     * @tparam UseExceptions: If false code uses assert() instead of throwing exceptions for invalid input
+     * @return Decompressed size, 0 on invalid input.
+     */
+    template <bool UseExceptions = true>
+    inline size_t LZDecompressBlock(std::span<const std::byte> src, std::span<std::byte> dest)
+    {
+        size_t decompressedSize{0};
+        if (!LZTryDecompressBlock(src, dest, decompressedSize))
+        {
+            if constexpr (UseExceptions)
+            {
+                throw std::runtime_error("Invalid or truncated compressed block.");
+            }
+            else
+            {
+                assert(false && "Invalid or truncated compressed block.");
+            }
+            return 0;
+        }
+
+        return decompressedSize;
+    }
+
+    /**
+     * Largest chunk compressed as one frame by LZCompressingSink.
+     */
+    constexpr size_t LZMaxFrameSize = 4 * 1024 * 1024;
+
+    /**
+     * Wrap a BinaryStreamWriter sink so every flushed chunk is compressed before it is passed on.
+     * Each chunk is written as a frame: 4 byte little endian raw size, 4 byte little endian stored size and
+     * the block. Chunks that do not compress are stored as is, marked by equal sizes.
+     * @param sink: Sink receiving the frames.
+     * @param maxChainLength: Passed to LZBlockCompressor.
+     */
+    inline std::function<bool(std::span<const std::byte>)> LZCompressingSink(
+        std::function<bool(std::span<const std::byte>)> sink,
+        size_t                                          maxChainLength = LZBlockCompressor::DefaultMaxChainLength)
+    {
+        auto pCompressor = std::make_shared<LZBlockCompressor>(maxChainLength);
+        auto pBuffer     = std::make_shared<std::vector<std::byte>>();
+
+        return [sink = std::move(sink), pCompressor, pBuffer](std::span<const std::byte> bytes) {
+            while (!bytes.empty())
+            {
+                std::span<const std::byte> chunk = bytes.first(std::min(bytes.size(), LZMaxFrameSize));
+                bytes                            = bytes.subspan(chunk.size());
+
+                std::vector<std::byte>& buffer = *pBuffer;
+                buffer.resize(8 + LZGetMaxCompressedSize(chunk.size()));
+                size_t storedSize = pCompressor->Compress(chunk, std::span(buffer).subspan(8));
+                if (storedSize == 0 || storedSize >= chunk.size())
+                {
+                    storedSize = chunk.size();
+                    std::memcpy(buffer.data() + 8, chunk.data(), chunk.size());
+                }
+
+                SerializeArithmaticType<uint32_t>(static_cast<uint32_t>(chunk.size()), buffer.data());
+                SerializeArithmaticType<uint32_t>(static_cast<uint32_t>(storedSize), buffer.data() + 4);
+                if (!sink(std::span<const std::byte>(buffer.data(), 8 + storedSize)))
+                    return false;
+            }
+            return true;
+        };
+    }
+
+    /**
+     * Wrap a BinaryStreamReader source reading frames written by LZCompressingSink.
+     * @return Source yielding the decompressed bytes, -1 for truncated or invalid frames.
+     */
+    inline std::function<std::ptrdiff_t(std::span<std::byte>)> LZDecompressingSource(
+        std::function<std::ptrdiff_t(std::span<std::byte>)> source)
+    {
+        struct State
+        {
+            std::function<std::ptrdiff_t(std::span<std::byte>)> Source;
+            std::vector<std::byte>                               Frame;
+            std::vector<std::byte>                               Data;
+            size_t                                               ReadLoc = 0;
+
+            /**
+             * @return Number of bytes read, less than bytes.size() only at the end of the source.
+             */
+            std::ptrdiff_t readFull(std::span<std::byte> bytes)
+            {
+                size_t numRead{0};
+                while (numRead < bytes.size())
+                {
+                    std::ptrdiff_t result = Source(bytes.subspan(numRead));
+                    if (result < 0)
+                        return result;
+                    if (result == 0)
+                        break;
+                    numRead += static_cast<size_t>(result);
+                }
+                return static_cast<std::ptrdiff_t>(numRead);
+            }
+
+            /**
+             * @return 1 if a frame was decoded, 0 at the end of the source, -1 on errors.
+             */
+            int nextFrame()
+            {
+                std::byte      header[8];
+                std::ptrdiff_t numRead = readFull(header);
+                if (numRead == 0)
+                    return 0;
+                if (numRead != 8)
+                    return -1;
+
+                size_t rawSize    = DeSerializeArithmaticType<uint32_t>(header);
+                size_t storedSize = DeSerializeArithmaticType<uint32_t>(header + 4);
+                if (rawSize > LZMaxFrameSize || storedSize > LZGetMaxCompressedSize(rawSize))
+                    return -1;
+
+                Data.resize(rawSize);
+                ReadLoc = 0;
+                if (storedSize == rawSize)
+                    return readFull(Data) == static_cast<std::ptrdiff_t>(rawSize) ? 1 : -1;
+
+                Frame.resize(storedSize);
+                if (readFull(Frame) != static_cast<std::ptrdiff_t>(storedSize))
+                    return -1;
+
+                size_t decompressedSize{0};
+                return LZTryDecompressBlock(Frame, Data, decompressedSize) && decompressedSize == rawSize ? 1 : -1;
+            }
+        };
+
+        auto pState    = std::make_shared<State>();
+        pState->Source = std::move(source);
+
+        return [pState](std::span<std::byte> bytes) -> std::ptrdiff_t {
+            State& state = *pState;
+            while (state.ReadLoc == state.Data.size())
+            {
+                int result = state.nextFrame();
+                if (result <= 0)
+                    return result;
+            }
+
+            size_t numCopied = std::min(bytes.size(), state.Data.size() - state.ReadLoc);
+            std::memcpy(bytes.data(), state.Data.data() + state.ReadLoc, numCopied);
+            state.ReadLoc += numCopied;
+            return static_cast<std::ptrdiff_t>(numCopied);
+        };
+    }
+} // namespace Shared
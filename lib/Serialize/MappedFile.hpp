@@ -0,0 +1,214 @@
+#pragma once
+
+#include "BinaryWriter.hpp"
+#include "SerializeDeserializeNum.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Shared {
+    /**
+     * Expected access pattern of a mapped file, passed to the kernel as a madvise() hint.
+     */
+    enum class AccessPattern
+    {
+        Normal,
+        Sequential, ///< Aggressive read-ahead, pages behind the read position may be dropped early
+        Random,     ///< No read-ahead
+    };
+
+    /**
+     * Read-only memory mapping of a whole file.
+     * Opening is constant time regardless of the file size, pages are loaded lazily by the kernel as they
+     * are first touched. The mapping is released when the object is destroyed.
+     * Only available on POSIX systems, Open() fails elsewhere.
+     */
+    class MappedFile {
+      public:
+        MappedFile()
+            : m_pData(nullptr)
+            , m_Size(0)
+            , m_IsOpen(false)
+        {
+        }
+
+        /**
+         * Map a file, see Open(). Check IsOpen() for success.
+         */
+        explicit MappedFile(const std::string& path, AccessPattern pattern = AccessPattern::Sequential)
+            : MappedFile()
+        {
+            Open(path, pattern);
+        }
+
+        MappedFile(const MappedFile&)            = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        MappedFile(MappedFile&& other) noexcept
+            : m_pData(other.m_pData)
+            , m_Size(other.m_Size)
+            , m_IsOpen(other.m_IsOpen)
+        {
+            other.m_pData  = nullptr;
+            other.m_Size   = 0;
+            other.m_IsOpen = false;
+        }
+
+        MappedFile& operator=(MappedFile&& other) noexcept
+        {
+            if (this != &other)
+            {
+                Close();
+                m_pData        = other.m_pData;
+                m_Size         = other.m_Size;
+                m_IsOpen       = other.m_IsOpen;
+                other.m_pData  = nullptr;
+                other.m_Size   = 0;
+                other.m_IsOpen = false;
+            }
+            return *this;
+        }
+
+        ~MappedFile() { Close(); }
+
+        /**
+         * Map a file read-only, replacing any current mapping.
+         * @param path: File to map.
+         * @param pattern: Access pattern hint for the kernel.
+         * @return false if the file could not be opened or mapped.
+         */
+        bool Open(const std::string& path, AccessPattern pattern = AccessPattern::Sequential)
+        {
+            Close();
+
+#if defined(__unix__) || defined(__APPLE__)
+            int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0)
+                return false;
+
+            struct stat fileStat;
+            if (::fstat(fd, &fileStat) != 0 || static_cast<uint64_t>(fileStat.st_size) > SIZE_MAX)
+            {
+                ::close(fd);
+                return false;
+            }
+
+            m_Size = static_cast<size_t>(fileStat.st_size);
+            if (m_Size > 0)
+            {
+                void* pMapping = ::mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (pMapping == MAP_FAILED)
+                {
+                    ::close(fd);
+                    m_Size = 0;
+                    return false;
+                }
+                m_pData = static_cast<const unsigned char*>(pMapping);
+                Advise(pattern);
+            }
+
+            // The mapping keeps the file referenced, the descriptor is no longer needed.
+            ::close(fd);
+            m_IsOpen = true;
+            return true;
+#else
+            (void)path;
+            (void)pattern;
+            return false;
+#endif
+        }
+
+        /**
+         * Release the mapping. Views and readers created from it become invalid.
+         */
+        void Close()
+        {
+#if defined(__unix__) || defined(__APPLE__)
+            if (m_pData != nullptr)
+            {
+                ::munmap(const_cast<unsigned char*>(m_pData), m_Size);
+            }
+#endif
+            m_pData  = nullptr;
+            m_Size   = 0;
+            m_IsOpen = false;
+        }
+
+        bool IsOpen() const { return m_IsOpen; }
+
+        /**
+         * Change the access pattern hint for the whole mapping.
+         */
+        void Advise(AccessPattern pattern) const
+        {
+#if defined(__unix__) || defined(__APPLE__)
+            if (m_pData == nullptr)
+                return;
+
+            int advice = pattern == AccessPattern::Sequential ? MADV_SEQUENTIAL
+                         : pattern == AccessPattern::Random   ? MADV_RANDOM
+                                                              : MADV_NORMAL;
+            ::madvise(const_cast<unsigned char*>(m_pData), m_Size, advice);
+#else
+            (void)pattern;
+#endif
+        }
+
+        /**
+         * Ask the kernel to start loading a range of the file in the background.
+         * @param offset: First byte of the range.
+         * @param length: Number of bytes in the range, clamped to the end of the file.
+         */
+        void WillNeed(size_t offset, size_t length) const
+        {
+#if defined(__unix__) || defined(__APPLE__)
+            if (offset >= m_Size)
+                return;
+
+            // madvise() requires a page aligned start address.
+            size_t pageSize = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+            size_t begin    = offset - offset % pageSize;
+            size_t end      = offset + std::min(length, m_Size - offset);
+            ::madvise(const_cast<unsigned char*>(m_pData) + begin, end - begin, MADV_WILLNEED);
+#else
+            (void)offset;
+            (void)length;
+#endif
+        }
+
+        const unsigned char* GetData() const { return m_pData; }
+        size_t GetSize() const { return m_Size; }
+
+        std::span<const std::byte> GetBytes() const
+        {
+            return std::span<const std::byte>(reinterpret_cast<const std::byte*>(m_pData), m_Size);
+        }
+
+        /**
+         * Create a reader over the whole mapping with the BinaryWriter read API.
+         * The reader is only valid while the mapping is.
+         * @tparam UseExceptions: Passed to BinaryWriter.
+         * @tparam endianess: Byte order the file was written with.
+         */
+        template <bool UseExceptions = true, Endianess endianess = Endianess::LittleEndian>
+        BinaryWriter<const unsigned char*, UseExceptions, endianess> CreateReader() const
+        {
+            return BinaryWriter<const unsigned char*, UseExceptions, endianess>(m_pData, m_pData + m_Size);
+        }
+
+      private:
+        const unsigned char* m_pData;
+        size_t               m_Size;
+        bool                 m_IsOpen;
+    };
+} // namespace Shared
@@ -0,0 +1,144 @@
+#pragma once
+
+#include "ArithmaticArrayView.hpp"
+#include "SerializeDeserializeNum.hpp"
+#include "StructSerializer.hpp"
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+
+namespace Shared
+{
+    template<auto LHS, auto RHS>
+    constexpr bool IsSameMember()
+    {
+        if constexpr (std::is_same<decltype(LHS), decltype(RHS)>::value) {
+            return LHS == RHS;
+        } else {
+            return false;
+        }
+    };
+
+    /**
+     * @return Packed offset of MEMBER in the field list, or the size of the whole list if it is not listed.
+     */
+    template<auto MEMBER, auto... MEMBERS>
+    constexpr size_t FieldListOffset(FieldList<MEMBERS...>)
+    {
+        size_t offset{0};
+        bool   found{false};
+        ((found = found || IsSameMember<MEMBER, MEMBERS>(),
+          offset += found ? 0 : WireFormat<MemberFieldType<MEMBERS>>::Size),
+         ...);
+
+        return found ? offset : StructWireSize<typename MemberPointerTraits<decltype(MEMBER)>::classType>;
+    };
+
+    /**
+     * Byte offset of MEMBER in the packed wire layout of T described by StructFields<T>.
+     */
+    template<class T, auto MEMBER>
+    constexpr size_t StructFieldOffset = FieldListOffset<MEMBER>(typename StructFields<T>::fieldListType{});
+
+    /**
+     * Non-owning, read-only view over a serialized struct described by StructFields.
+     * Field offsets are resolved at compile time, so each getter decodes a single field directly from the
+     * buffer without reading the fields in front of it or materializing the message.
+     * The underlying buffer must outlive the view.
+     * @tparam T: Struct the bytes were serialized from.
+     * @tparam endianess: Endianess the struct was serialized with.
+     */
+    template<class T, Endianess endianess = Endianess::LittleEndian>
+    class MessageView
+    {
+      public:
+        MessageView()
+            : m_pData(nullptr)
+        {
+        }
+
+        /**
+         * Construct view over a serialized struct.
+         * @param bytes: Serialized struct, must hold at least StructWireSize<T> bytes.
+         */
+        explicit MessageView(std::span<const std::byte> bytes)
+            : m_pData(bytes.data())
+        {
+            assert(bytes.size() >= StructWireSize<T>);
+        }
+
+        /**
+         * Decode a single field.
+         * @tparam MEMBER: Pointer to the member of T to decode, e.g. &Header::Length.
+         * @return Decoded field value.
+         */
+        template<auto MEMBER>
+        MemberFieldType<MEMBER> Get() const
+        {
+            typedef MemberFieldType<MEMBER> fieldType;
+            constexpr size_t                offset = fieldOffset<MEMBER>();
+
+            if constexpr (std::is_arithmetic<fieldType>::value) {
+                return DeSerializeArithmaticType<fieldType, endianess>(m_pData + offset);
+            } else {
+                return ReadWireValue<fieldType, endianess>(m_pData + offset);
+            }
+        }
+
+        /**
+         * @tparam MEMBER: Pointer to a nested struct member of T.
+         * @return View over the nested struct, its fields are decoded on access as well.
+         */
+        template<auto MEMBER>
+        MessageView<MemberFieldType<MEMBER>, endianess> GetView() const
+        {
+            return MessageView<MemberFieldType<MEMBER>, endianess>(GetBytes<MEMBER>());
+        }
+
+        /**
+         * @tparam MEMBER: Pointer to a std::array member of T with arithmatic elements.
+         * @return View decoding the array elements on access.
+         */
+        template<auto MEMBER>
+        auto GetArrayView() const
+        {
+            typedef typename MemberFieldType<MEMBER>::value_type valueType;
+
+            return ArithmaticArrayView<valueType, endianess>(GetBytes<MEMBER>());
+        }
+
+        /**
+         * @tparam MEMBER: Pointer to the member of T. Omit to get the bytes of the whole struct.
+         * @return Raw serialized bytes of the field.
+         */
+        template<auto MEMBER>
+        std::span<const std::byte> GetBytes() const
+        {
+            return std::span<const std::byte>(m_pData + fieldOffset<MEMBER>(),
+                                              WireFormat<MemberFieldType<MEMBER>>::Size);
+        }
+
+        std::span<const std::byte> GetBytes() const { return std::span<const std::byte>(m_pData, StructWireSize<T>); }
+
+        /**
+         * Decode the whole struct.
+         */
+        void Materialize(T& value) const { DeSerializeStruct<T, endianess>(m_pData, value); }
+
+      private:
+        template<auto MEMBER>
+        static constexpr size_t fieldOffset()
+        {
+            static_assert(std::is_same<typename MemberPointerTraits<decltype(MEMBER)>::classType, T>::value,
+                          "MEMBER must be a member of T.");
+            static_assert(StructFieldOffset<T, MEMBER> < StructWireSize<T>, "MEMBER is not listed in StructFields<T>.");
+
+            return StructFieldOffset<T, MEMBER>;
+        }
+
+        const std::byte* m_pData;
+    };
+} // namespace Shared
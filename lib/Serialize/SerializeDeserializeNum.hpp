@@ -1,7 +1,13 @@
 #pragma once
 
+#include <bit>
+#include <cassert>
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <iterator>
+#include <memory>
+#include <span>
 #include <stddef.h>
 #include <stdexcept>
 #include <type_traits>
@@ -14,6 +20,119 @@ namespace Shared
         LittleEndian
     };
 
+    /**
+     * Unsigned integer type with the same size as T, used to move arithmetic values around as raw bits.
+     */
+    template<class T>
+    using ArithmaticStorageType = typename std::conditional<
+        sizeof(T) == 1,
+        uint8_t,
+        typename std::conditional<sizeof(T) == 2,
+                                  uint16_t,
+                                  typename std::conditional<sizeof(T) == 4, uint32_t, uint64_t>::type>::type>::type;
+
+    /**
+     * @return true if values laid out in memory by the host already match the requested endianess.
+     */
+    template<Endianess endianess>
+    constexpr bool IsNativeEndianess()
+    {
+        return (endianess == Endianess::LittleEndian && std::endian::native == std::endian::little) ||
+               (endianess == Endianess::BigEndian && std::endian::native == std::endian::big);
+    }
+
+    /**
+     * Reverse the byte order of an unsigned integral value.
+     */
+    template<class T>
+    constexpr T ByteSwap(T value)
+    {
+        static_assert(std::is_unsigned<T>::value, "T must be unsigned integral type.");
+
+        if constexpr (sizeof(T) == 1) {
+            return value;
+        } else if (std::is_constant_evaluated()) {
+            T swapped{0};
+            for (size_t i = 0; i < sizeof(T); ++i) {
+                swapped |= ((value >> (8 * i)) & 0xFF) << (8 * (sizeof(T) - 1 - i));
+            }
+            return swapped;
+        } else {
+#if defined(_MSC_VER) && !defined(__clang__)
+            if constexpr (sizeof(T) == 2) {
+                return _byteswap_ushort(value);
+            } else if constexpr (sizeof(T) == 4) {
+                return _byteswap_ulong(value);
+            } else {
+                return _byteswap_uint64(value);
+            }
+#else
+            if constexpr (sizeof(T) == 2) {
+                return __builtin_bswap16(value);
+            } else if constexpr (sizeof(T) == 4) {
+                return __builtin_bswap32(value);
+            } else {
+                return __builtin_bswap64(value);
+            }
+#endif
+        }
+    };
+
+    /**
+     * Serialize an arithmatic value into exactly sizeof(T) bytes.
+     * The byte order is resolved at compile time from std::endian::native, so this compiles to a single
+     * unaligned store, plus a byte swap when the requested endianess differs from the host.
+     * @param value: Value to serialize.
+     * @param pDest: Destination buffer, must hold sizeof(T) bytes.
+     */
+    template<class T, Endianess endianess = Endianess::LittleEndian, class BYTE_TYPE>
+    static void SerializeArithmaticType(T value, BYTE_TYPE* pDest)
+    {
+        static_assert(std::is_same<BYTE_TYPE, std::byte>::value || std::is_same<BYTE_TYPE, unsigned char>::value,
+                      "BYTE_TYPE must be std::byte/unsigned char");
+        static_assert(std::is_arithmetic<T>::value, "T must be arithmatic type.");
+
+        typedef ArithmaticStorageType<T> storageType;
+        storageType rawValue = std::bit_cast<storageType>(value);
+        if constexpr (!IsNativeEndianess<endianess>()) {
+            rawValue = ByteSwap(rawValue);
+        }
+        std::memcpy(pDest, &rawValue, sizeof(T));
+    };
+
+    template<class T, Endianess endianess = Endianess::LittleEndian>
+    static void SerializeArithmaticType(T value, std::span<std::byte, sizeof(T)> dest)
+    {
+        SerializeArithmaticType<T, endianess>(value, dest.data());
+    };
+
+    /**
+     * Deserialize an arithmatic value from exactly sizeof(T) bytes, see the matching SerializeArithmaticType.
+     * @param pSrc: Source buffer, must hold sizeof(T) bytes.
+     * @return Deserialized value.
+     */
+    template<class T, Endianess endianess = Endianess::LittleEndian, class BYTE_TYPE>
+    static T DeSerializeArithmaticType(const BYTE_TYPE* pSrc)
+    {
+        static_assert(std::is_same<BYTE_TYPE, std::byte>::value || std::is_same<BYTE_TYPE, unsigned char>::value,
+                      "BYTE_TYPE must be std::byte/unsigned char");
+        static_assert(std::is_arithmetic<T>::value, "T must be arithmatic type.");
+
+        typedef ArithmaticStorageType<T> storageType;
+        storageType rawValue;
+        std::memcpy(&rawValue, pSrc, sizeof(T));
+        if constexpr (!IsNativeEndianess<endianess>()) {
+            rawValue = ByteSwap(rawValue);
+        }
+        return std::bit_cast<T>(rawValue);
+    };
+
+    template<class T, Endianess endianess = Endianess::LittleEndian>
+    static T DeSerializeArithmaticType(std::span<const std::byte, sizeof(T)> src)
+    {
+        return DeSerializeArithmaticType<T, endianess>(src.data());
+    };
+
     template<class T, class INPUT_IT, Endianess endianess = Endianess::LittleEndian, bool UseExceptions = true>
     static void SerializeArithmaticType(T value, INPUT_IT begin, INPUT_IT end)
     {
@@ -33,7 +152,9 @@ namespace Shared
             assert(numElements == sizeof(value));
         }
 
-        if constexpr (std::is_integral<T>::value) {
+        if constexpr (std::contiguous_iterator<INPUT_IT>) {
+            SerializeArithmaticType<T, endianess>(value, std::to_address(begin));
+        } else if constexpr (std::is_integral<T>::value) {
             if constexpr (endianess == Endianess::LittleEndian) {
                 for (int i = 0; i < numElements; ++i) {
                     *(begin + i) =
@@ -82,6 +203,10 @@ namespace Shared
             assert(numElements == sizeof(T));
         }
 
+        if constexpr (std::contiguous_iterator<INPUT_IT>) {
+            return DeSerializeArithmaticType<T, endianess>(std::to_address(begin));
+        }
+
         T value{0};
 
         if constexpr (std::is_integral<T>::value) {
@@ -111,6 +236,58 @@ namespace Shared
         return value;
     };
 
+    /**
+     * Serialize a contiguous array of arithmatic values in one pass.
+     * When the requested endianess matches the host this is a single memcpy, otherwise every element is
+     * byte swapped in a branch free loop the compiler can vectorize.
+     * @param pValues: Pointer to the first value to serialize.
+     * @param count: Number of values to serialize.
+     * @param pDest: Destination buffer, must hold count * sizeof(T) bytes.
+     */
+    template<class T, class BYTE_TYPE, Endianess endianess = Endianess::LittleEndian>
+    static void SerializeArithmaticArray(const T* pValues, size_t count, BYTE_TYPE* pDest)
+    {
+        static_assert(std::is_same<BYTE_TYPE, std::byte>::value || std::is_same<BYTE_TYPE, unsigned char>::value,
+                      "BYTE_TYPE must be std::byte/unsigned char");
+        static_assert(std::is_arithmetic<T>::value, "T must be arithmatic type.");
+
+        if (count == 0)
+            return;
+
+        if constexpr (IsNativeEndianess<endianess>() || sizeof(T) == 1) {
+            std::memcpy(pDest, pValues, count * sizeof(T));
+        } else {
+            for (size_t i = 0; i < count; ++i) {
+                SerializeArithmaticType<T, endianess>(pValues[i], pDest + i * sizeof(T));
+            }
+        }
+    };
+
+    /**
+     * Deserialize a contiguous array of arithmatic values in one pass, see SerializeArithmaticArray.
+     * @param pSrc: Source buffer, must hold count * sizeof(T) bytes.
+     * @param count: Number of values to deserialize.
+     * @param pValues: Pointer to the first value to fill.
+     */
+    template<class T, class BYTE_TYPE, Endianess endianess = Endianess::LittleEndian>
+    static void DeSerializeArithmaticArray(const BYTE_TYPE* pSrc, size_t count, T* pValues)
+    {
+        static_assert(std::is_same<BYTE_TYPE, std::byte>::value || std::is_same<BYTE_TYPE, unsigned char>::value,
+                      "BYTE_TYPE must be std::byte/unsigned char");
+        static_assert(std::is_arithmetic<T>::value, "T must be arithmatic type.");
+
+        if (count == 0)
+            return;
+
+        if constexpr (IsNativeEndianess<endianess>() || sizeof(T) == 1) {
+            std::memcpy(pValues, pSrc, count * sizeof(T));
+        } else {
+            for (size_t i = 0; i < count; ++i) {
+                pValues[i] = DeSerializeArithmaticType<T, endianess>(pSrc + i * sizeof(T));
+            }
+        }
+    };
+
     template<class T, class INPUT_IT, Endianess endianess = Endianess::LittleEndian>
     static void SerializeIntegralType(T integralValue, INPUT_IT begin, INPUT_IT end)
     {
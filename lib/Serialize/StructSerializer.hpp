@@ -0,0 +1,375 @@
+#pragma once
+
+#include "BitSetTemplate.hpp"
+#include "Enum/Enum.hpp"
+#include "FixedPoint.hpp"
+#include "SerializeDeserializeNum.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+namespace Shared
+{
+    /**
+     * Wire layout of a struct. Specialize for each struct to serialize, listing its members in wire order:
+     *
+     *     template<> struct StructFields<Header> : FieldList<&Header::Id, &Header::Flags, &Header::Length> {};
+     *
+     * Members may be arithmatic types, enums, std::array, Enum, FixedPoint, BitSetTemplate or other structs
+     * with a StructFields specialization. Values are packed without padding.
+     */
+    template<class T>
+    struct StructFields;
+
+    template<auto... MEMBERS>
+    struct FieldList {
+        typedef FieldList fieldListType;
+    };
+
+    /**
+     * Serialization of a single field type, specialize to support additional field types.
+     * Size: Number of bytes the value occupies on the wire.
+     * RawLayout: true if the in-memory bytes of T equal its native endian wire bytes. Such types also
+     * provide Pattern(), returning a constant value whose bytes all differ between Pattern(false) and
+     * Pattern(true), which is used to locate members at compile time.
+     * Types without a default constructor also provide ReadValue(), returning the value read, see ReadWireValue().
+     */
+    template<class T>
+    struct WireFormat;
+
+    template<class MEMBER_PTR>
+    struct MemberPointerTraits;
+
+    template<class C, class F>
+    struct MemberPointerTraits<F C::*> {
+        typedef C classType;
+        typedef F fieldType;
+    };
+
+    template<auto MEMBER>
+    using MemberFieldType = typename MemberPointerTraits<decltype(MEMBER)>::fieldType;
+
+    template<class T>
+        requires std::is_arithmetic_v<T>
+    struct WireFormat<T> {
+        static constexpr size_t Size      = sizeof(T);
+        static constexpr bool   RawLayout = true;
+
+        template<Endianess endianess>
+        static void Write(const T& value, std::byte* pDest)
+        {
+            SerializeArithmaticType<T, endianess>(value, pDest);
+        }
+
+        template<Endianess endianess>
+        static void Read(const std::byte* pSrc, T& value)
+        {
+            value = DeSerializeArithmaticType<T, endianess>(pSrc);
+        }
+
+        static constexpr T Pattern(bool high)
+        {
+            if constexpr (std::is_same<T, bool>::value) {
+                return high;
+            } else {
+                typedef ArithmaticStorageType<T> storageType;
+                return std::bit_cast<T>(high ? static_cast<storageType>(~storageType(0)) : storageType(0));
+            }
+        }
+    };
+
+    template<class T>
+        requires std::is_enum_v<T>
+    struct WireFormat<T> {
+        typedef std::underlying_type_t<T> integralType;
+
+        static constexpr size_t Size      = sizeof(integralType);
+        static constexpr bool   RawLayout = true;
+
+        template<Endianess endianess>
+        static void Write(const T& value, std::byte* pDest)
+        {
+            SerializeArithmaticType<integralType, endianess>(static_cast<integralType>(value), pDest);
+        }
+
+        template<Endianess endianess>
+        static void Read(const std::byte* pSrc, T& value)
+        {
+            value = static_cast<T>(DeSerializeArithmaticType<integralType, endianess>(pSrc));
+        }
+
+        static constexpr T Pattern(bool high) { return static_cast<T>(WireFormat<integralType>::Pattern(high)); }
+    };
+
+    template<class T, size_t N>
+    struct WireFormat<std::array<T, N>> {
+        static constexpr size_t Size      = N * WireFormat<T>::Size;
+        static constexpr bool   RawLayout = WireFormat<T>::RawLayout && sizeof(std::array<T, N>) == Size;
+
+        template<Endianess endianess>
+        static void Write(const std::array<T, N>& values, std::byte* pDest)
+        {
+            if constexpr (std::is_arithmetic<T>::value) {
+                SerializeArithmaticArray<T, std::byte, endianess>(values.data(), N, pDest);
+            } else {
+                for (size_t i = 0; i < N; ++i) {
+                    WireFormat<T>::template Write<endianess>(values[i], pDest + i * WireFormat<T>::Size);
+                }
+            }
+        }
+
+        template<Endianess endianess>
+        static void Read(const std::byte* pSrc, std::array<T, N>& values)
+        {
+            if constexpr (std::is_arithmetic<T>::value) {
+                DeSerializeArithmaticArray<T, std::byte, endianess>(pSrc, N, values.data());
+            } else {
+                for (size_t i = 0; i < N; ++i) {
+                    WireFormat<T>::template Read<endianess>(pSrc + i * WireFormat<T>::Size, values[i]);
+                }
+            }
+        }
+
+        static constexpr std::array<T, N> Pattern(bool high)
+        {
+            std::array<T, N> values{};
+            for (T& value : values) {
+                value = WireFormat<T>::Pattern(high);
+            }
+            return values;
+        }
+    };
+
+    template<class T_ENUM, T_ENUM ENUM_BEGIN, T_ENUM ENUM_END, class T_INT, class Derived>
+    T_INT EnumIntegralType(const Enum<T_ENUM, ENUM_BEGIN, ENUM_END, T_INT, Derived>*);
+
+    /**
+     * Enum values are written as T_INT and validated with FromIntegral() when read.
+     */
+    template<class T>
+        requires requires(const T* pValue) { EnumIntegralType(pValue); }
+    struct WireFormat<T> {
+        typedef decltype(EnumIntegralType(static_cast<const T*>(nullptr))) integralType;
+
+        static constexpr size_t Size      = sizeof(integralType);
+        static constexpr bool   RawLayout = false;
+
+        template<Endianess endianess>
+        static void Write(const T& value, std::byte* pDest)
+        {
+            SerializeArithmaticType<integralType, endianess>(value.ToIntegral(), pDest);
+        }
+
+        template<Endianess endianess>
+        static void Read(const std::byte* pSrc, T& value)
+        {
+            value.FromIntegral(DeSerializeArithmaticType<integralType, endianess>(pSrc));
+        }
+    };
+
+    /**
+     * FixedPoint values are written as their BASE_TYPE raw value, which is also their in-memory layout.
+     */
+    template<class BASE_TYPE, size_t INT_BITS, size_t FRAC_BITS>
+    struct WireFormat<FixedPoint<BASE_TYPE, INT_BITS, FRAC_BITS>> {
+        typedef FixedPoint<BASE_TYPE, INT_BITS, FRAC_BITS> fixedPointType;
+
+        static constexpr size_t Size      = sizeof(BASE_TYPE);
+        static constexpr bool   RawLayout = sizeof(fixedPointType) == sizeof(BASE_TYPE);
+
+        template<Endianess endianess>
+        static void Write(const fixedPointType& value, std::byte* pDest)
+        {
+            SerializeArithmaticType<BASE_TYPE, endianess>(value.ToIntegral(), pDest);
+        }
+
+        template<Endianess endianess>
+        static void Read(const std::byte* pSrc, fixedPointType& value)
+        {
+            value = fixedPointType(DeSerializeArithmaticType<BASE_TYPE, endianess>(pSrc));
+        }
+
+        static constexpr fixedPointType Pattern(bool high)
+        {
+            return fixedPointType::FromRaw(WireFormat<BASE_TYPE>::Pattern(high));
+        }
+    };
+
+    /**
+     * BitSetTemplate values are written as their BASE_TYPE raw value and validated against VALIDITY_MASK
+     * when read.
+     */
+    template<class BIT_ID_TYPE, class BASE_TYPE, BASE_TYPE VALIDITY_MASK>
+    struct WireFormat<BitSetTemplate<BIT_ID_TYPE, BASE_TYPE, VALIDITY_MASK>> {
+        typedef BitSetTemplate<BIT_ID_TYPE, BASE_TYPE, VALIDITY_MASK> bitSetType;
+
+        static constexpr size_t Size      = sizeof(BASE_TYPE);
+        static constexpr bool   RawLayout = false;
+
+        template<Endianess endianess>
+        static void Write(const bitSetType& value, std::byte* pDest)
+        {
+            SerializeArithmaticType<BASE_TYPE, endianess>(value.GetRawValue(), pDest);
+        }
+
+        template<Endianess endianess>
+        static void Read(const std::byte* pSrc, bitSetType& value)
+        {
+            value = ReadValue<endianess>(pSrc);
+        }
+
+        template<Endianess endianess>
+        static bitSetType ReadValue(const std::byte* pSrc)
+        {
+            return bitSetType(DeSerializeArithmaticType<BASE_TYPE, endianess>(pSrc));
+        }
+    };
+
+    /**
+     * Read a single field value, also for field types without a default constructor.
+     * @param pSrc: Source buffer, must hold WireFormat<T>::Size bytes.
+     * @return Value read.
+     */
+    template<class T, Endianess endianess>
+    T ReadWireValue(const std::byte* pSrc)
+    {
+        if constexpr (requires { WireFormat<T>::template ReadValue<endianess>(pSrc); }) {
+            return WireFormat<T>::template ReadValue<endianess>(pSrc);
+        } else {
+            T value{};
+            WireFormat<T>::template Read<endianess>(pSrc, value);
+            return value;
+        }
+    }
+
+    /**
+     * Byte offset of MEMBER inside T, found by comparing the object representation of two constants that only
+     * differ in that member.
+     */
+    template<class T, auto MEMBER>
+    constexpr size_t StructMemberOffset()
+    {
+        T lowValue{};
+        T highValue{};
+        lowValue.*MEMBER  = WireFormat<MemberFieldType<MEMBER>>::Pattern(false);
+        highValue.*MEMBER = WireFormat<MemberFieldType<MEMBER>>::Pattern(true);
+
+        auto lowBytes  = std::bit_cast<std::array<unsigned char, sizeof(T)>>(lowValue);
+        auto highBytes = std::bit_cast<std::array<unsigned char, sizeof(T)>>(highValue);
+
+        size_t offset{0};
+        while (lowBytes[offset] == highBytes[offset]) {
+            ++offset;
+        }
+        return offset;
+    };
+
+    /**
+     * @return true if T has no padding and every listed member sits at its packed wire offset, so the struct
+     * is its own native endian wire image.
+     */
+    template<class T, auto... MEMBERS>
+    constexpr bool StructHasRawLayout()
+    {
+        constexpr size_t size = (WireFormat<MemberFieldType<MEMBERS>>::Size + ... + 0);
+
+        if constexpr (!std::is_trivially_copyable<T>::value || sizeof(T) != size) {
+            return false;
+        } else if constexpr (!(WireFormat<MemberFieldType<MEMBERS>>::RawLayout && ...)) {
+            return false;
+        } else if constexpr (!requires { typename std::bool_constant<(T{}, true)>; }) {
+            return false;
+        } else {
+            size_t packedOffset{0};
+            bool   inOrder{true};
+            ((inOrder = inOrder && StructMemberOffset<T, MEMBERS>() == packedOffset,
+              packedOffset += WireFormat<MemberFieldType<MEMBERS>>::Size),
+             ...);
+            return inOrder;
+        }
+    };
+
+    template<class T, class FIELD_LIST>
+    struct StructWireFormat;
+
+    template<class T, auto... MEMBERS>
+    struct StructWireFormat<T, FieldList<MEMBERS...>> {
+        static constexpr size_t Size      = (WireFormat<MemberFieldType<MEMBERS>>::Size + ... + 0);
+        static constexpr bool   RawLayout = StructHasRawLayout<T, MEMBERS...>();
+
+        template<Endianess endianess>
+        static void Write(const T& value, std::byte* pDest)
+        {
+            if constexpr (RawLayout && IsNativeEndianess<endianess>()) {
+                std::memcpy(pDest, &value, Size);
+            } else {
+                size_t offset{0};
+                ((WireFormat<MemberFieldType<MEMBERS>>::template Write<endianess>(value.*MEMBERS, pDest + offset),
+                  offset += WireFormat<MemberFieldType<MEMBERS>>::Size),
+                 ...);
+            }
+        }
+
+        template<Endianess endianess>
+        static void Read(const std::byte* pSrc, T& value)
+        {
+            if constexpr (RawLayout && IsNativeEndianess<endianess>()) {
+                std::memcpy(&value, pSrc, Size);
+            } else {
+                size_t offset{0};
+                ((WireFormat<MemberFieldType<MEMBERS>>::template Read<endianess>(pSrc + offset, value.*MEMBERS),
+                  offset += WireFormat<MemberFieldType<MEMBERS>>::Size),
+                 ...);
+            }
+        }
+
+        static constexpr T Pattern(bool high)
+        {
+            T value{};
+            ((value.*MEMBERS = WireFormat<MemberFieldType<MEMBERS>>::Pattern(high)), ...);
+            return value;
+        }
+    };
+
+    template<class T>
+        requires requires { typename StructFields<T>::fieldListType; }
+    struct WireFormat<T> : StructWireFormat<T, typename StructFields<T>::fieldListType> {
+    };
+
+    /**
+     * Number of bytes T occupies on the wire, known at compile time.
+     */
+    template<class T>
+    constexpr size_t StructWireSize = WireFormat<T>::Size;
+
+    /**
+     * Serialize a struct described by StructFields into exactly StructWireSize<T> bytes.
+     * Structs whose memory layout already matches the wire layout are copied with a single memcpy.
+     * @param value: Value to serialize.
+     * @param pDest: Destination buffer, must hold StructWireSize<T> bytes.
+     */
+    template<class T, Endianess endianess = Endianess::LittleEndian, class BYTE_TYPE>
+    static void SerializeStruct(const T& value, BYTE_TYPE* pDest)
+    {
+        static_assert(std::is_same<BYTE_TYPE, std::byte>::value || std::is_same<BYTE_TYPE, unsigned char>::value,
+                      "BYTE_TYPE must be std::byte/unsigned char");
+
+        WireFormat<T>::template Write<endianess>(value, reinterpret_cast<std::byte*>(pDest));
+    };
+
+    /**
+     * Deserialize a struct described by StructFields from exactly StructWireSize<T> bytes.
+     * @param pSrc: Source buffer, must hold StructWireSize<T> bytes.
+     * @param value: Set to the deserialized value.
+     */
+    template<class T, Endianess endianess = Endianess::LittleEndian, class BYTE_TYPE>
+    static void DeSerializeStruct(const BYTE_TYPE* pSrc, T& value)
+    {
+        static_assert(std::is_same<BYTE_TYPE, std::byte>::value || std::is_same<BYTE_TYPE, unsigned char>::value,
+                      "BYTE_TYPE must be std::byte/unsigned char");
+
+        WireFormat<T>::template Read<endianess>(reinterpret_cast<const std::byte*>(pSrc), value);
+    };
+} // namespace Shared
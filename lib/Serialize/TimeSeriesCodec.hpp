@@ -0,0 +1,296 @@
+#pragma once
+
+#include "BitStream.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace Shared {
+    /**
+     * Gorilla style compression for series of (timestamp, double) samples.
+     *
+     * Timestamps are stored as the difference between consecutive deltas, which is zero for regularly
+     * sampled series and costs a single bit:
+     *   0                      delta of delta is 0
+     *   10   + 7 bit signed    -64 to 63
+     *   110  + 9 bit signed    -256 to 255
+     *   1110 + 12 bit signed   -2048 to 2047
+     *   1111 + 64 bit          anything else
+     * Values are XORed with the previous value and only the meaningful bits of the result are stored:
+     *   0                                  same value as before
+     *   10 + meaningful bits               fits the previous leading/trailing zero window
+     *   11 + 5 bit leading zeros + 6 bit length - 1 + meaningful bits
+     * The first sample is stored uncompressed. Prefix bits are listed in stream order.
+     */
+
+    /**
+     * Streaming encoder, samples are appended one at a time.
+     */
+    class TimeSeriesEncoder {
+      public:
+        /**
+         * @param initialCapacity: Number of bytes to reserve for the encoded output.
+         */
+        explicit TimeSeriesEncoder(size_t initialCapacity = 0)
+            : m_Writer(initialCapacity)
+            , m_Count(0)
+            , m_PrevTimestamp(0)
+            , m_PrevDelta(0)
+            , m_PrevValue(0)
+            , m_PrevLeading(64)
+            , m_PrevTrailing(0)
+        {
+        }
+
+        /**
+         * Discard all samples, keeping the buffer capacity.
+         */
+        void Clear()
+        {
+            m_Writer.Clear();
+            m_Count         = 0;
+            m_PrevTimestamp = 0;
+            m_PrevDelta     = 0;
+            m_PrevValue     = 0;
+            m_PrevLeading   = 64;
+            m_PrevTrailing  = 0;
+        }
+
+        /**
+         * @return Number of samples appended.
+         */
+        size_t GetCount() const { return m_Count; }
+
+        /**
+         * @return Encoded size so far in bits.
+         */
+        size_t GetBitSize() const { return m_Writer.GetBitSize(); }
+
+        void Append(int64_t timestamp, double value)
+        {
+            uint64_t bits = std::bit_cast<uint64_t>(value);
+            if (m_Count == 0)
+            {
+                m_Writer.WriteBits(static_cast<uint64_t>(timestamp), 64);
+                m_Writer.WriteBits(bits, 64);
+            }
+            else
+            {
+                appendTimestamp(timestamp);
+                appendValue(bits);
+            }
+
+            m_PrevTimestamp = timestamp;
+            m_PrevValue     = bits;
+            ++m_Count;
+        }
+
+        void Append(std::span<const int64_t> timestamps, std::span<const double> values)
+        {
+            assert(timestamps.size() == values.size());
+            for (size_t i = 0; i < timestamps.size(); ++i)
+            {
+                Append(timestamps[i], values[i]);
+            }
+        }
+
+        /**
+         * Pad the stream to a whole byte.
+         * @return Encoded samples, valid until the next Append(). GetCount() samples have to be decoded.
+         */
+        std::span<const std::byte> Flush() { return m_Writer.Flush(); }
+
+      private:
+        void appendTimestamp(int64_t timestamp)
+        {
+            // Unsigned arithmetic keeps the deltas well defined when they overflow, the decoder wraps back.
+            int64_t delta        = static_cast<int64_t>(static_cast<uint64_t>(timestamp) - m_PrevTimestamp);
+            int64_t deltaOfDelta = static_cast<int64_t>(static_cast<uint64_t>(delta) - m_PrevDelta);
+            m_PrevDelta          = static_cast<uint64_t>(delta);
+
+            // Prefixes are written LSB first, so 0b01 is "10" in stream order.
+            if (deltaOfDelta == 0)
+            {
+                m_Writer.WriteBits(0b0, 1);
+            }
+            else if (deltaOfDelta >= -64 && deltaOfDelta <= 63)
+            {
+                m_Writer.WriteBits(0b01, 2);
+                m_Writer.WriteSignedBits(deltaOfDelta, 7);
+            }
+            else if (deltaOfDelta >= -256 && deltaOfDelta <= 255)
+            {
+                m_Writer.WriteBits(0b011, 3);
+                m_Writer.WriteSignedBits(deltaOfDelta, 9);
+            }
+            else if (deltaOfDelta >= -2048 && deltaOfDelta <= 2047)
+            {
+                m_Writer.WriteBits(0b0111, 4);
+                m_Writer.WriteSignedBits(deltaOfDelta, 12);
+            }
+            else
+            {
+                m_Writer.WriteBits(0b1111, 4);
+                m_Writer.WriteSignedBits(deltaOfDelta, 64);
+            }
+        }
+
+        void appendValue(uint64_t bits)
+        {
+            uint64_t xorValue = bits ^ m_PrevValue;
+            if (xorValue == 0)
+            {
+                m_Writer.WriteBits(0b0, 1);
+                return;
+            }
+
+            size_t leading  = std::min<size_t>(std::countl_zero(xorValue), 31);
+            size_t trailing = std::countr_zero(xorValue);
+            if (leading >= m_PrevLeading && trailing >= m_PrevTrailing)
+            {
+                m_Writer.WriteBits(0b01, 2);
+                m_Writer.WriteBits(xorValue >> m_PrevTrailing, 64 - m_PrevLeading - m_PrevTrailing);
+                return;
+            }
+
+            size_t length = 64 - leading - trailing;
+            m_Writer.WriteBits(0b11, 2);
+            m_Writer.WriteBits(leading, 5);
+            m_Writer.WriteBits(length - 1, 6);
+            m_Writer.WriteBits(xorValue >> trailing, length);
+            m_PrevLeading  = leading;
+            m_PrevTrailing = trailing;
+        }
+
+        BitWriter m_Writer;
+        size_t    m_Count;
+        uint64_t  m_PrevTimestamp;
+        uint64_t  m_PrevDelta;
+        uint64_t  m_PrevValue;
+        size_t    m_PrevLeading;
+        size_t    m_PrevTrailing;
+    };
+
+    /**
+     * Decoder for series written by TimeSeriesEncoder.
+     * @tparam UseExceptions: If false code uses assert() instead of throwing exceptions for truncated input
+     */
+    template <bool UseExceptions = true>
+    class TimeSeriesDecoder {
+      public:
+        /**
+         * @param bytes: Output of TimeSeriesEncoder::Flush(), must stay valid while decoding.
+         * @param count: Number of encoded samples, TimeSeriesEncoder::GetCount().
+         */
+        TimeSeriesDecoder(std::span<const std::byte> bytes, size_t count)
+            : m_Reader(bytes)
+            , m_Remaining(count)
+            , m_IsFirst(true)
+            , m_PrevTimestamp(0)
+            , m_PrevDelta(0)
+            , m_PrevValue(0)
+            , m_PrevLeading(0)
+            , m_PrevTrailing(0)
+        {
+        }
+
+        /**
+         * @return Number of samples not decoded yet.
+         */
+        size_t GetRemaining() const { return m_Remaining; }
+
+        /**
+         * Decode the next sample.
+         * @return false if all samples have been decoded.
+         */
+        bool Next(int64_t& timestamp, double& value)
+        {
+            if (m_Remaining == 0)
+                return false;
+
+            if (m_IsFirst)
+            {
+                m_PrevTimestamp = m_Reader.ReadBits(64);
+                m_PrevValue     = m_Reader.ReadBits(64);
+                m_IsFirst       = false;
+            }
+            else
+            {
+                m_PrevDelta += readDeltaOfDelta();
+                m_PrevTimestamp += m_PrevDelta;
+                m_PrevValue ^= readXor();
+            }
+
+            timestamp = static_cast<int64_t>(m_PrevTimestamp);
+            value     = std::bit_cast<double>(m_PrevValue);
+            --m_Remaining;
+            return true;
+        }
+
+        /**
+         * Decode up to count samples into the output arrays.
+         * @return Number of samples decoded.
+         */
+        size_t Decode(int64_t* pTimestamps, double* pValues, size_t count)
+        {
+            size_t numDecoded{0};
+            while (numDecoded < count && Next(pTimestamps[numDecoded], pValues[numDecoded]))
+            {
+                ++numDecoded;
+            }
+            return numDecoded;
+        }
+
+        /**
+         * Decode a whole block of count samples.
+         */
+        static void DecodeBlock(std::span<const std::byte> bytes, size_t count, int64_t* pTimestamps, double* pValues)
+        {
+            TimeSeriesDecoder decoder(bytes, count);
+            decoder.Decode(pTimestamps, pValues, count);
+        }
+
+      private:
+        uint64_t readDeltaOfDelta()
+        {
+            if (!m_Reader.ReadBool())
+                return 0;
+            if (!m_Reader.ReadBool())
+                return static_cast<uint64_t>(m_Reader.ReadSignedBits(7));
+            if (!m_Reader.ReadBool())
+                return static_cast<uint64_t>(m_Reader.ReadSignedBits(9));
+            if (!m_Reader.ReadBool())
+                return static_cast<uint64_t>(m_Reader.ReadSignedBits(12));
+
+            return m_Reader.ReadBits(64);
+        }
+
+        uint64_t readXor()
+        {
+            if (!m_Reader.ReadBool())
+                return 0;
+
+            if (m_Reader.ReadBool())
+            {
+                m_PrevLeading  = static_cast<size_t>(m_Reader.ReadBits(5));
+                size_t length  = static_cast<size_t>(m_Reader.ReadBits(6)) + 1;
+                m_PrevTrailing = 64 - m_PrevLeading - std::min<size_t>(length, 64 - m_PrevLeading);
+            }
+
+            return m_Reader.ReadBits(64 - m_PrevLeading - m_PrevTrailing) << m_PrevTrailing;
+        }
+
+        BitReader<UseExceptions> m_Reader;
+        size_t                   m_Remaining;
+        bool                     m_IsFirst;
+        uint64_t                 m_PrevTimestamp;
+        uint64_t                 m_PrevDelta;
+        uint64_t                 m_PrevValue;
+        size_t                   m_PrevLeading;
+        size_t                   m_PrevTrailing;
+    };
+} // namespace Shared
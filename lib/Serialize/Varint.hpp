@@ -0,0 +1,249 @@
+#pragma once
+
+#include "SerializeDeserializeNum.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#endif
+
+namespace Shared
+{
+    /**
+     * Maximum number of bytes a LEB128 varint of type T can occupy.
+     */
+    template<class T>
+    constexpr size_t MaxVarintSize = (sizeof(T) * 8 + 6) / 7;
+
+    /**
+     * Map a signed value onto an unsigned one so small magnitudes (positive or negative) stay small.
+     * 0 -> 0, -1 -> 1, 1 -> 2, -2 -> 3, ...
+     */
+    template<class T>
+    constexpr std::make_unsigned_t<T> ZigZagEncode(T value)
+    {
+        static_assert(std::is_integral<T>::value && std::is_signed<T>::value, "T must be signed integral type.");
+        typedef std::make_unsigned_t<T> unsignedType;
+
+        return static_cast<unsignedType>(static_cast<unsignedType>(value) << 1) ^
+               static_cast<unsignedType>(value >> (sizeof(T) * 8 - 1));
+    };
+
+    /**
+     * Inverse of ZigZagEncode.
+     */
+    template<class T>
+    constexpr std::make_signed_t<T> ZigZagDecode(T value)
+    {
+        static_assert(std::is_integral<T>::value && std::is_unsigned<T>::value, "T must be unsigned integral type.");
+
+        return static_cast<std::make_signed_t<T>>((value >> 1) ^ (~(value & 1) + 1));
+    };
+
+    /**
+     * @return Number of bytes needed to encode value as a LEB128 varint.
+     */
+    constexpr size_t VarintSize(uint64_t value)
+    {
+        return 1 + (std::bit_width(value | 1) - 1) / 7;
+    };
+
+    /**
+     * Convert an integral value to the unsigned representation stored in a varint.
+     * Signed values are ZigZag encoded.
+     */
+    template<class T>
+    constexpr uint64_t ToVarintValue(T value)
+    {
+        static_assert(std::is_integral<T>::value, "T must be integral type.");
+
+        if constexpr (std::is_signed<T>::value) {
+            return ZigZagEncode(value);
+        } else {
+            return value;
+        }
+    };
+
+    /**
+     * Convert the unsigned representation stored in a varint back to T.
+     * @param rawValue: Decoded varint value.
+     * @param value: Set to the converted value.
+     * @return false if rawValue does not fit in T.
+     */
+    template<class T>
+    constexpr bool FromVarintValue(uint64_t rawValue, T& value)
+    {
+        static_assert(std::is_integral<T>::value, "T must be integral type.");
+        typedef std::make_unsigned_t<T> unsignedType;
+
+        if (rawValue > std::numeric_limits<unsignedType>::max())
+            return false;
+
+        if constexpr (std::is_signed<T>::value) {
+            value = ZigZagDecode(static_cast<unsignedType>(rawValue));
+        } else {
+            value = static_cast<T>(rawValue);
+        }
+
+        return true;
+    };
+
+    /**
+     * Encode value as a LEB128 varint.
+     * @param value: Value to encode.
+     * @param pDest: Destination buffer, must hold at least VarintSize(value) bytes.
+     * @return Number of bytes written.
+     */
+    template<class BYTE_TYPE>
+    static size_t EncodeVarint(uint64_t value, BYTE_TYPE* pDest)
+    {
+        static_assert(std::is_same<BYTE_TYPE, std::byte>::value || std::is_same<BYTE_TYPE, unsigned char>::value,
+                      "BYTE_TYPE must be std::byte/unsigned char");
+
+        size_t numBytes{0};
+        while (value >= 0x80) {
+            pDest[numBytes++] = static_cast<BYTE_TYPE>((value & 0x7F) | 0x80);
+            value >>= 7;
+        }
+        pDest[numBytes++] = static_cast<BYTE_TYPE>(value);
+
+        return numBytes;
+    };
+
+    /**
+     * Decode a LEB128 varint.
+     * When at least 8 bytes are readable the length is found with a single count-trailing-zeros over the
+     * continuation bits and the 7 bit groups are compacted with a fixed sequence of masks and shifts.
+     * @param pSrc: First byte of the varint.
+     * @param pEnd: End of the readable buffer.
+     * @param value: Set to the decoded value.
+     * @return Number of bytes consumed, 0 if the varint is truncated or malformed.
+     */
+    template<class BYTE_TYPE>
+    static size_t DecodeVarint(const BYTE_TYPE* pSrc, const BYTE_TYPE* pEnd, uint64_t& value)
+    {
+        static_assert(std::is_same<BYTE_TYPE, std::byte>::value || std::is_same<BYTE_TYPE, unsigned char>::value,
+                      "BYTE_TYPE must be std::byte/unsigned char");
+
+        constexpr uint64_t continuationBits = 0x8080808080808080;
+
+        if (pEnd - pSrc >= 8) {
+            uint64_t word;
+            std::memcpy(&word, pSrc, sizeof(word));
+            if constexpr (std::endian::native == std::endian::big) {
+                word = ByteSwap(word);
+            }
+
+            uint64_t stopBits = ~word & continuationBits;
+            if (stopBits != 0) {
+                size_t numBytes = (std::countr_zero(stopBits) + 1) / 8;
+                uint64_t keepMask = numBytes == 8 ? ~uint64_t(0) : (uint64_t(1) << (numBytes * 8)) - 1;
+
+                uint64_t x = word & keepMask & ~continuationBits;
+                x = ((x & 0x7F007F007F007F00) >> 1) | (x & 0x007F007F007F007F);
+                x = ((x & 0x3FFF00003FFF0000) >> 2) | (x & 0x00003FFF00003FFF);
+                x = ((x & 0x0FFFFFFF00000000) >> 4) | (x & 0x000000000FFFFFFF);
+
+                value = x;
+                return numBytes;
+            }
+        }
+
+        uint64_t result{0};
+        for (size_t i = 0; i < MaxVarintSize<uint64_t>; ++i) {
+            if (pSrc + i == pEnd)
+                return 0;
+
+            uint64_t byte = static_cast<uint64_t>(pSrc[i]);
+            if (i == MaxVarintSize<uint64_t> - 1 && byte > 1)
+                return 0;
+
+            result |= (byte & 0x7F) << (7 * i);
+            if ((byte & 0x80) == 0) {
+                value = result;
+                return i + 1;
+            }
+        }
+
+        return 0;
+    };
+
+    /**
+     * Count the single byte varints at the start of a buffer, looking at up to 16 bytes at once with SSE2
+     * or 8 bytes at once with a portable word test.
+     * @param pSrc: First byte to examine.
+     * @param available: Number of readable bytes.
+     * @return Number of leading bytes without a continuation bit, 0 if too few bytes are readable to test.
+     */
+    template<class BYTE_TYPE>
+    static size_t CountSingleByteVarints(const BYTE_TYPE* pSrc, size_t available)
+    {
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        if (available >= 16) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc));
+            unsigned int continuationMask = static_cast<unsigned int>(_mm_movemask_epi8(chunk));
+            return continuationMask == 0 ? 16 : std::countr_zero(continuationMask);
+        }
+#endif
+        if (available >= 8) {
+            uint64_t word;
+            std::memcpy(&word, pSrc, sizeof(word));
+            if constexpr (std::endian::native == std::endian::big) {
+                word = ByteSwap(word);
+            }
+            uint64_t continuationBits = word & 0x8080808080808080;
+            return continuationBits == 0 ? 8 : std::countr_zero(continuationBits) / 8;
+        }
+
+        return 0;
+    };
+
+    /**
+     * Decode count consecutive varints into pValues.
+     * Runs of single byte varints (the common case for small counters and deltas) are found with
+     * CountSingleByteVarints and widened without per-byte branches.
+     * @param pSrc: First byte of the first varint.
+     * @param pEnd: End of the readable buffer.
+     * @param pValues: Destination for the decoded values.
+     * @param count: Number of values to decode.
+     * @return Pointer past the last consumed byte, nullptr if the data is truncated, malformed or out of
+     * range for T.
+     */
+    template<class T, class BYTE_TYPE>
+    static const BYTE_TYPE* DecodeVarintArray(const BYTE_TYPE* pSrc, const BYTE_TYPE* pEnd, T* pValues, size_t count)
+    {
+        static_assert(std::is_integral<T>::value, "T must be integral type.");
+
+        while (count > 0) {
+            size_t numSingleBytes = std::min(count, CountSingleByteVarints(pSrc, static_cast<size_t>(pEnd - pSrc)));
+            if (numSingleBytes > 0) {
+                for (size_t i = 0; i < numSingleBytes; ++i) {
+                    // Single byte varints always fit in T, signed or not.
+                    FromVarintValue(static_cast<uint64_t>(pSrc[i]), pValues[i]);
+                }
+                pSrc += numSingleBytes;
+                pValues += numSingleBytes;
+                count -= numSingleBytes;
+                continue;
+            }
+
+            uint64_t rawValue;
+            size_t numBytes = DecodeVarint(pSrc, pEnd, rawValue);
+            if (numBytes == 0 || !FromVarintValue(rawValue, *pValues))
+                return nullptr;
+
+            pSrc += numBytes;
+            ++pValues;
+            --count;
+        }
+
+        return pSrc;
+    };
+} // namespace Shared
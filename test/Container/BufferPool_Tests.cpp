@@ -0,0 +1,118 @@
+#include <Container/BufferPool.hpp>
+#include <Serialize/BinaryWriter.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+namespace Shared {
+    /**
+     * Upstream resource counting the allocations that reach it.
+     */
+    class CountingResource : public std::pmr::memory_resource {
+      public:
+        size_t m_NumAllocations   = 0;
+        size_t m_NumDeallocations = 0;
+
+      protected:
+        void* do_allocate(size_t bytes, size_t alignment) override
+        {
+            ++m_NumAllocations;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override
+        {
+            ++m_NumDeallocations;
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+    };
+
+    TEST(BufferPool_Tests, ValidateSizeClasses)
+    {
+        CountingResource upstream;
+        {
+            BufferPool pool(2, &upstream);
+
+            void* pSmall = pool.allocate(10);
+            void* pLarge = pool.allocate(BufferPool::MaxBlockSize + 1);
+            EXPECT_EQ(2, upstream.m_NumAllocations);
+
+            pool.deallocate(pSmall, 10);
+            pool.deallocate(pLarge, BufferPool::MaxBlockSize + 1);
+            EXPECT_EQ(1, pool.GetCachedBlockCount());
+            EXPECT_EQ(1, upstream.m_NumDeallocations);
+
+            // Any size in the same class reuses the cached block.
+            EXPECT_EQ(pSmall, pool.allocate(64));
+            EXPECT_EQ(0, pool.GetCachedBlockCount());
+            pool.deallocate(pSmall, 64);
+
+            void* p1 = pool.allocate(1000);
+            void* p2 = pool.allocate(1024);
+            void* p3 = pool.allocate(513);
+            EXPECT_EQ(5, upstream.m_NumAllocations);
+            pool.deallocate(p1, 1000);
+            pool.deallocate(p2, 1024);
+            pool.deallocate(p3, 513);
+            EXPECT_EQ(3, pool.GetCachedBlockCount());
+            EXPECT_EQ(2, upstream.m_NumDeallocations);
+
+            pool.Release();
+            EXPECT_EQ(0, pool.GetCachedBlockCount());
+            EXPECT_EQ(upstream.m_NumAllocations, upstream.m_NumDeallocations);
+        }
+        EXPECT_EQ(upstream.m_NumAllocations, upstream.m_NumDeallocations);
+    }
+
+    TEST(BufferPool_Tests, ValidateSteadyStateBinaryWriter)
+    {
+        CountingResource upstream;
+        BufferPool       pool(16, &upstream);
+
+        auto serializeMessage = [&](uint32_t i) {
+            pmr::BinaryWriter<> writer(64, &pool);
+            for (uint32_t j = 0; j < 100; ++j)
+            {
+                writer.WriteNum(i + j);
+            }
+            writer.Reset();
+            EXPECT_EQ(i, writer.ReadNum<uint32_t>());
+            EXPECT_EQ(&pool, writer.GetAllocator().resource());
+        };
+
+        serializeMessage(0);
+        size_t warmAllocations = upstream.m_NumAllocations;
+        for (uint32_t i = 1; i < 1000; ++i)
+        {
+            serializeMessage(i);
+        }
+        EXPECT_EQ(warmAllocations, upstream.m_NumAllocations);
+
+        BufferPool& threadPool = BufferPool::ThreadLocal();
+        EXPECT_EQ(&threadPool, &BufferPool::ThreadLocal());
+        pmr::BinaryWriter<> threadWriter(0, &threadPool);
+        threadWriter.WriteNum(uint64_t(1));
+        EXPECT_EQ(sizeof(uint64_t), threadWriter.GetSize());
+    }
+
+    TEST(BufferPool_Tests, ValidateArenaBinaryWriter)
+    {
+        std::array<std::byte, 4096>         arena;
+        std::pmr::monotonic_buffer_resource resource(arena.data(), arena.size(), std::pmr::null_memory_resource());
+
+        pmr::BinaryWriter<false, Endianess::BigEndian> writer(0, &resource);
+        const std::vector<uint16_t>                     values(500, 0x0102);
+        writer.WriteArrayNum(values.begin(), values.end());
+        EXPECT_GE(writer.GetBegin(), reinterpret_cast<unsigned char*>(arena.data()));
+        EXPECT_LT(writer.GetBegin(), reinterpret_cast<unsigned char*>(arena.data() + arena.size()));
+
+        writer.Reset();
+        EXPECT_EQ(values, writer.ReadArrayNum<uint16_t>());
+    }
+} // namespace Shared
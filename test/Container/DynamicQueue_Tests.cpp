@@ -0,0 +1,208 @@
+#include <Container/DynamicQueue.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+
+namespace Shared {
+    TEST(DynamicQueue_Tests, ValidateConstruction)
+    {
+        DynamicQueue<int> queue;
+        EXPECT_TRUE(queue.Empty());
+        EXPECT_EQ(0, queue.Size());
+        EXPECT_EQ(0, queue.Capacity());
+        EXPECT_FALSE(queue.Full());
+
+        DynamicQueue<int> reserved(100);
+        EXPECT_TRUE(reserved.Empty());
+        EXPECT_EQ(128, reserved.Capacity());
+
+        EXPECT_THROW(reserved.Reserve(SIZE_MAX), std::length_error);
+        EXPECT_THROW(reserved.Reserve(reserved.MaxSize() + 1), std::length_error);
+        EXPECT_EQ(128, reserved.Capacity());
+    }
+
+    TEST(DynamicQueue_Tests, ValidateFillEmpty)
+    {
+        DynamicQueue<int> queue;
+        ASSERT_FALSE(queue.Pop());
+        for (int y = 0; y < 5; ++y)
+        {
+            // Offset the head so growth has to unwrap the ring.
+            ASSERT_TRUE(queue.Push(-1));
+            ASSERT_TRUE(queue.Push(-1));
+            ASSERT_TRUE(queue.Pop());
+            ASSERT_TRUE(queue.Pop());
+
+            for (int i = 0; i < 1000; ++i)
+            {
+                ASSERT_TRUE(queue.Push(i));
+                ASSERT_EQ(i + 1, queue.Size());
+                ASSERT_EQ(i, queue.Back());
+                ASSERT_EQ(0, queue.Front());
+            }
+
+            int i{0};
+            while (!queue.Empty())
+            {
+                ASSERT_EQ(i++, queue.Front());
+                ASSERT_TRUE(queue.Pop());
+            }
+            ASSERT_EQ(1000, i);
+        }
+        EXPECT_EQ(1024, queue.Capacity());
+    }
+
+    TEST(DynamicQueue_Tests, ValidateIterator)
+    {
+        DynamicQueue<int> queue;
+
+        for (int i = 0; i < 6; ++i)
+        {
+            queue.Push(-1);
+            queue.Pop();
+        }
+        for (int i = 0; i < 20; ++i)
+        {
+            queue.Push(i);
+        }
+
+        int i{0};
+        for (auto it = queue.Begin(); it != queue.End(); ++it)
+        {
+            ASSERT_EQ(i++, *it);
+        }
+
+        for (int j = 1; j < 20; ++j)
+        {
+            queue.Pop();
+
+            i = j;
+            for (auto it = queue.Begin(); it != queue.End(); ++it)
+            {
+                ASSERT_EQ(i++, *it);
+            }
+        }
+    }
+
+    TEST(DynamicQueue_Tests, ValidateReserveShrinkToFit)
+    {
+        DynamicQueue<std::string> queue;
+        queue.Reserve(33);
+        EXPECT_EQ(64, queue.Capacity());
+        queue.Reserve(10);
+        EXPECT_EQ(64, queue.Capacity());
+
+        for (int i = 0; i < 60; ++i)
+        {
+            queue.Push(std::to_string(i));
+        }
+        for (int i = 0; i < 50; ++i)
+        {
+            queue.Pop();
+        }
+        for (int i = 60; i < 65; ++i)
+        {
+            queue.Push(std::to_string(i));
+        }
+
+        queue.ShrinkToFit();
+        EXPECT_EQ(16, queue.Capacity());
+        ASSERT_EQ(15, queue.Size());
+
+        int i{50};
+        for (auto it = queue.Begin(); it != queue.End(); ++it)
+        {
+            EXPECT_EQ(std::to_string(i++), *it);
+        }
+
+        queue.Clear();
+        queue.ShrinkToFit();
+        EXPECT_EQ(0, queue.Capacity());
+    }
+
+    TEST(DynamicQueue_Tests, ValidateCopyMove)
+    {
+        DynamicQueue<std::unique_ptr<int>> moveOnly;
+        for (int i = 0; i < 10; ++i)
+        {
+            moveOnly.Emplace(std::make_unique<int>(i));
+        }
+        DynamicQueue<std::unique_ptr<int>> movedTo(std::move(moveOnly));
+        EXPECT_TRUE(moveOnly.Empty());
+        ASSERT_EQ(10, movedTo.Size());
+        EXPECT_EQ(9, *movedTo.Back());
+
+        DynamicQueue<int> queue;
+        for (int i = 0; i < 10; ++i)
+        {
+            queue.Push(i);
+        }
+        DynamicQueue<int> copy(queue);
+        queue.Pop();
+        EXPECT_EQ(10, copy.Size());
+        EXPECT_EQ(0, copy.Front());
+
+        copy = queue;
+        EXPECT_EQ(9, copy.Size());
+        EXPECT_EQ(1, copy.Front());
+    }
+
+    TEST(DynamicQueue_Tests, ValidateGrowthFromOwnElement)
+    {
+        // Long enough to live on the heap, a moved from string would be empty.
+        const std::string text(64, 'x');
+
+        DynamicQueue<std::string> queue;
+        for (int i = 0; i < 8; ++i)
+        {
+            queue.Push(text + std::to_string(i));
+        }
+        ASSERT_EQ(queue.Size(), queue.Capacity());
+
+        // Each call grows the storage while its argument is still in the old storage.
+        queue.Emplace(queue.Front());
+        EXPECT_EQ(text + "0", queue.Back());
+
+        while (queue.Size() < queue.Capacity())
+        {
+            queue.Push(text);
+        }
+        queue.Push(queue.Front());
+        EXPECT_EQ(text + "0", queue.Back());
+
+        while (queue.Size() < queue.Capacity())
+        {
+            queue.Push(text);
+        }
+        queue.Push(std::move(queue.Front()));
+        EXPECT_EQ(text + "0", queue.Back());
+        EXPECT_TRUE(queue.Front().empty());
+        EXPECT_EQ(64, queue.Capacity());
+    }
+
+    TEST(DynamicQueue_Tests, ValidatePolymorphicAllocator)
+    {
+        std::array<std::byte, 4096>         buffer;
+        std::pmr::monotonic_buffer_resource resource(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+
+        pmr::DynamicQueue<int> queue(&resource);
+        for (int i = 0; i < 100; ++i)
+        {
+            queue.Push(i);
+        }
+        EXPECT_EQ(&resource, queue.GetAllocator().resource());
+
+        std::pmr::monotonic_buffer_resource otherResource;
+        pmr::DynamicQueue<int>              other(&otherResource);
+        other = std::move(queue);
+        EXPECT_EQ(&otherResource, other.GetAllocator().resource());
+        ASSERT_EQ(100, other.Size());
+        EXPECT_EQ(0, other.Front());
+        EXPECT_EQ(99, other.Back());
+    }
+} // namespace Shared
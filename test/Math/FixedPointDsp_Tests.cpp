@@ -0,0 +1,196 @@
+#include <Math/FixedPointDsp.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+#include <random>
+#include <vector>
+
+namespace Shared {
+    typedef FixedPoint<int16_t, 1, 15>  Q1_15;
+    typedef FixedPoint<int16_t, 2, 14>  Q2_14;
+    typedef FixedPoint<int32_t, 16, 16> Q16_16;
+    typedef FixedPoint<int32_t, 2, 30>  Q2_30;
+
+    template <class FIXED_TYPE>
+    std::vector<FIXED_TYPE> MakeRandomValues(size_t count, uint32_t seed)
+    {
+        std::mt19937                           generator(seed);
+        std::uniform_int_distribution<int32_t> distribution(FIXED_TYPE::MinRawValue, FIXED_TYPE::MaxRawValue);
+
+        std::vector<FIXED_TYPE> values(count);
+        for (auto& value : values)
+        {
+            value = FIXED_TYPE::FromRaw(static_cast<FixedPointDsp::BaseType<FIXED_TYPE>>(distribution(generator)));
+        }
+        return values;
+    }
+
+    TEST(FixedPointDsp_Tests, ValidateDotProduct)
+    {
+        std::vector<Q1_15> lhs = MakeRandomValues<Q1_15>(1000, 1);
+        std::vector<Q1_15> rhs = MakeRandomValues<Q1_15>(1000, 2);
+
+        // Every length covers the AVX2, SSE2 and scalar parts.
+        for (size_t count = 0; count < 100; ++count)
+        {
+            int64_t expected{0};
+            for (size_t i = 0; i < count; ++i)
+            {
+                expected += int64_t(lhs[i].ToIntegral()) * rhs[i].ToIntegral();
+            }
+            ASSERT_EQ(expected, FixedPointDsp::DotProductRaw(lhs.data(), rhs.data(), count)) << count;
+        }
+
+        // Raw -32768, e.g. from the wrapping operator-, makes a pmaddwd pair reach 2^31.
+        std::vector<Q1_15> minimums(40, Q1_15::FromRaw(-32767) - Q1_15::FromRaw(1));
+        for (size_t count = 0; count <= minimums.size(); ++count)
+        {
+            ASSERT_EQ(int64_t(count) << 30, FixedPointDsp::DotProductRaw(minimums.data(), minimums.data(), count))
+                << count;
+        }
+
+        std::vector<Q1_15> mixed = lhs;
+        for (size_t i = 0; i < mixed.size(); i += 3)
+        {
+            mixed[i] = minimums[0];
+        }
+        int64_t expected{0};
+        for (size_t i = 0; i < mixed.size(); ++i)
+        {
+            expected += int64_t(mixed[i].ToIntegral()) * mixed[i].ToIntegral();
+        }
+        EXPECT_EQ(expected, FixedPointDsp::DotProductRaw(mixed.data(), mixed.data(), mixed.size()));
+
+        // Sums far beyond 32 bits are exact.
+        std::vector<Q1_15> extremes(1000, Q1_15::FromRaw(Q1_15::MaxRawValue));
+        std::vector<Q1_15> negated(1000, Q1_15::FromRaw(Q1_15::MinRawValue));
+        EXPECT_EQ(int64_t(32767) * 32767 * 1000, FixedPointDsp::DotProductRaw(extremes.data(), extremes.data(), 1000));
+        EXPECT_EQ(-int64_t(32767) * 32767 * 1000, FixedPointDsp::DotProductRaw(extremes.data(), negated.data(), 1000));
+
+        // Rounded once to the result type and saturated.
+        std::vector<Q1_15> halves(8, Q1_15(0.5));
+        EXPECT_DOUBLE_EQ(2.0, FixedPointDsp::DotProduct<Q16_16>(halves.data(), halves.data(), 8).ToDouble());
+        EXPECT_EQ(Q1_15::MaxRawValue, FixedPointDsp::DotProduct<Q1_15>(halves.data(), halves.data(), 8).ToIntegral());
+        EXPECT_EQ(Q1_15::MinRawValue, FixedPointDsp::DotProduct<Q1_15>(halves.data(), negated.data(), 8).ToIntegral());
+
+        // Mixed and 32 bit types accumulate in 128 bits.
+        std::vector<Q16_16> wide(3, Q16_16(30000.0));
+        FixedPointDsp::AccumulatorType<Q16_16, Q16_16> wideRaw(int64_t(30000) << 16);
+        EXPECT_EQ(wideRaw * wideRaw * 3, FixedPointDsp::DotProductRaw(wide.data(), wide.data(), 3));
+        EXPECT_DOUBLE_EQ(30000.0, FixedPointDsp::DotProduct<Q16_16>(wide.data(), halves.data(), 2).ToDouble());
+        EXPECT_EQ(Q16_16::MinRawValue, FixedPointDsp::DotProduct<Q16_16>(wide.data(), negated.data(), 3).ToIntegral());
+    }
+
+    TEST(FixedPointDsp_Tests, ValidateFirFilter)
+    {
+        std::vector<Q1_15> coefficients = MakeRandomValues<Q1_15>(21, 3);
+        std::vector<Q1_15> input        = MakeRandomValues<Q1_15>(500, 4);
+
+        // Each output is the exact convolution rounded once.
+        std::vector<Q1_15> expected(input.size());
+        for (size_t n = 0; n < input.size(); ++n)
+        {
+            int64_t sum{0};
+            for (size_t k = 0; k < coefficients.size() && k <= n; ++k)
+            {
+                sum += int64_t(coefficients[k].ToIntegral()) * input[n - k].ToIntegral();
+            }
+            expected[n] = FixedPointDsp::FromAccumulator<Q1_15>(sum, 30);
+        }
+
+        FirFilter<Q1_15, Q1_15> filter(coefficients.data(), coefficients.size());
+        EXPECT_EQ(21, filter.GetNumTaps());
+
+        std::vector<Q1_15> output(input.size());
+        filter.Process(input.data(), output.data(), input.size());
+        EXPECT_EQ(expected, output);
+
+        // Blocks of any size carry the state over, in place processing works.
+        filter.Reset();
+        std::vector<Q1_15> blocks = input;
+        for (size_t begin = 0, size = 1; begin < blocks.size(); begin += size, size = size * 2 + 1)
+        {
+            size = std::min(size, blocks.size() - begin);
+            filter.Process(blocks.data() + begin, blocks.data() + begin, size);
+        }
+        EXPECT_EQ(expected, blocks);
+    }
+
+    TEST(FixedPointDsp_Tests, ValidateBiquadCascade)
+    {
+        // Two second order Butterworth low pass sections at 0.1 * sample rate.
+        auto makeSection = [](double q) {
+            double w0    = 2 * std::numbers::pi * 0.1;
+            double alpha = std::sin(w0) / (2 * q);
+            double a0    = 1 + alpha;
+            double b     = (1 - std::cos(w0)) / 2 / a0;
+            return std::array<double, 5>{b, 2 * b, b, -2 * std::cos(w0) / a0, (1 - alpha) / a0};
+        };
+        std::array<std::array<double, 5>, 2> coefficients{makeSection(0.5412), makeSection(1.3066)};
+
+        typedef BiquadCascade<Q1_15, Q2_14> filterType;
+        std::vector<filterType::Section>    sections;
+        for (const auto& c : coefficients)
+        {
+            sections.push_back({Q2_14(c[0]), Q2_14(c[1]), Q2_14(c[2]), Q2_14(c[3]), Q2_14(c[4])});
+        }
+        filterType filter(sections);
+        EXPECT_EQ(2, filter.GetNumSections());
+
+        std::vector<Q1_15> input(400);
+        for (size_t i = 0; i < input.size(); ++i)
+        {
+            input[i] = Q1_15(0.4 * std::sin(0.05 * i) + 0.4 * std::sin(2.5 * i));
+        }
+
+        std::vector<Q1_15> output(input.size());
+        filter.Process(input.data(), output.data(), input.size());
+
+        // Same filter in double with the quantized coefficients, the difference is only rounding noise.
+        std::vector<double> reference(input.size());
+        for (size_t i = 0; i < input.size(); ++i)
+        {
+            reference[i] = input[i].ToDouble();
+        }
+        for (const auto& section : sections)
+        {
+            double x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+            for (double& sample : reference)
+            {
+                double y = section.B0.ToDouble() * sample + section.B1.ToDouble() * x1 + section.B2.ToDouble() * x2 -
+                           section.A1.ToDouble() * y1 - section.A2.ToDouble() * y2;
+                x2     = x1;
+                x1     = sample;
+                y2     = y1;
+                y1     = y;
+                sample = y;
+            }
+        }
+        for (size_t i = 0; i < input.size(); ++i)
+        {
+            ASSERT_NEAR(reference[i], output[i].ToDouble(), 50 * Q1_15::GetStepSize()) << i;
+        }
+
+        // The high frequency component is removed.
+        EXPECT_NEAR(0.4 * std::sin(0.05 * 399), output[399].ToDouble(), 0.05);
+
+        // Blocks carry the state over, in place processing works.
+        filter.Reset();
+        std::vector<Q1_15> blocks = input;
+        filter.Process(blocks.data(), blocks.data(), 7);
+        filter.Process(blocks.data() + 7, blocks.data() + 7, blocks.size() - 7);
+        EXPECT_EQ(output, blocks);
+
+        // Coefficients in 32 bits accumulate in 128 bits.
+        std::vector<BiquadCascade<Q16_16, Q2_30>::Section> wideSections{
+            {Q2_30(0.5), Q2_30(0.25), Q2_30(0.0), Q2_30(-0.5), Q2_30(0.0)}};
+        BiquadCascade<Q16_16, Q2_30> wideFilter(wideSections);
+        std::vector<Q16_16>          steps(50, Q16_16(1000.0));
+        wideFilter.Process(steps.data(), steps.data(), steps.size());
+        EXPECT_NEAR(1500.0, steps.back().ToDouble(), Q16_16::GetStepSize());
+    }
+} // namespace Shared
@@ -0,0 +1,128 @@
+#include <Math/FixedPointMath.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+
+namespace Shared {
+    typedef FixedPoint<int32_t, 16, 16> Q16_16;
+    typedef FixedPoint<int32_t, 4, 28>  Q4_28;
+    typedef FixedPoint<int16_t, 4, 12>  Q4_12;
+    typedef FixedPoint<uint16_t, 8, 8>  UQ8_8;
+
+    // Half a step from rounding plus the documented error before rounding.
+    template <class FIXED_TYPE>
+    constexpr double CordicTolerance = FIXED_TYPE::GetStepSize() * 0.5 +
+                                       std::max(FIXED_TYPE::GetStepSize() / 8, 1.0 / (1 << 26));
+
+    template <class FIXED_TYPE>
+    void ValidateTrigonometry(double begin, double end, double increment)
+    {
+        for (double angle = begin; angle < end; angle += increment)
+        {
+            FIXED_TYPE value(angle);
+            double     exact = value.ToDouble();
+
+            ASSERT_NEAR(std::sin(exact), FixedPointMath::Sin(value).ToDouble(), CordicTolerance<FIXED_TYPE>) << exact;
+            ASSERT_NEAR(std::cos(exact), FixedPointMath::Cos(value).ToDouble(), CordicTolerance<FIXED_TYPE>) << exact;
+            ASSERT_NEAR(std::sin(exact), FixedPointMath::SinLookup(value).ToDouble(),
+                        FIXED_TYPE::GetStepSize() * 0.5 + 5e-6)
+                << exact;
+            ASSERT_NEAR(std::cos(exact), FixedPointMath::CosLookup(value).ToDouble(),
+                        FIXED_TYPE::GetStepSize() * 0.5 + 5e-6)
+                << exact;
+        }
+    }
+
+    TEST(FixedPointMath_Tests, ValidateSqrt)
+    {
+        static_assert(FixedPointMath::Sqrt(Q16_16(2.25)) == Q16_16(1.5));
+
+        for (int32_t raw = 0; raw < (1 << 20); raw += 97)
+        {
+            Q16_16 value = Q16_16::FromRaw(raw);
+            ASSERT_NEAR(std::sqrt(value.ToDouble()), FixedPointMath::Sqrt(value).ToDouble(), Q16_16::GetStepSize() / 2)
+                << raw;
+        }
+
+        EXPECT_NEAR(std::sqrt(Q16_16::GetMax()), FixedPointMath::Sqrt(Q16_16::FromRaw(Q16_16::MaxRawValue)).ToDouble(),
+                    Q16_16::GetStepSize() / 2);
+        EXPECT_DOUBLE_EQ(3.0, FixedPointMath::Sqrt(UQ8_8(9.0)).ToDouble());
+        EXPECT_EQ(0, FixedPointMath::Sqrt(Q16_16(-4.0)).ToIntegral());
+
+        // sqrt(0.9999) rounds to 1.0 which is out of range for Q1.15.
+        typedef FixedPoint<int16_t, 1, 15> Q1_15;
+        EXPECT_EQ(Q1_15::MaxRawValue, FixedPointMath::Sqrt(Q1_15::FromRaw(Q1_15::MaxRawValue)).ToIntegral());
+    }
+
+    TEST(FixedPointMath_Tests, ValidateSinCos)
+    {
+        static_assert(FixedPointMath::Sin(Q16_16(0.0)) == Q16_16(0.0));
+        static_assert(FixedPointMath::Cos(Q16_16(0.0)) == Q16_16(1.0));
+
+        ValidateTrigonometry<Q16_16>(-20.0, 20.0, 0.0123);
+        ValidateTrigonometry<Q4_28>(-7.9, 7.9, 0.00123);
+        ValidateTrigonometry<Q4_12>(-7.9, 7.9, 0.0123);
+
+        // Large angles are reduced without losing accuracy.
+        ValidateTrigonometry<Q16_16>(30000.0, 30100.0, 0.0987);
+
+        EXPECT_EQ(0, FixedPointMath::Sin(UQ8_8(4.0)).ToIntegral());
+    }
+
+    TEST(FixedPointMath_Tests, ValidateAtan2)
+    {
+        constexpr double pi = std::numbers::pi;
+
+        EXPECT_EQ(0, FixedPointMath::Atan2(Q16_16(0.0), Q16_16(0.0)).ToIntegral());
+        EXPECT_NEAR(pi, FixedPointMath::Atan2(Q16_16(0.0), Q16_16(-1.0)).ToDouble(), CordicTolerance<Q16_16>);
+        EXPECT_NEAR(-pi / 2, FixedPointMath::Atan2(Q16_16(-3.0), Q16_16(0.0)).ToDouble(), CordicTolerance<Q16_16>);
+
+        for (double y = -5.0; y < 5.0; y += 0.173)
+        {
+            for (double x = -5.0; x < 5.0; x += 0.311)
+            {
+                Q16_16 fixedY(y);
+                Q16_16 fixedX(x);
+                ASSERT_NEAR(std::atan2(fixedY.ToDouble(), fixedX.ToDouble()),
+                            FixedPointMath::Atan2(fixedY, fixedX).ToDouble(), CordicTolerance<Q16_16>)
+                    << y << ", " << x;
+            }
+        }
+
+        // Tiny and huge vectors keep their full angular precision.
+        EXPECT_NEAR(std::atan2(1.0, 2.0), FixedPointMath::Atan2(Q4_28::FromRaw(1), Q4_28::FromRaw(2)).ToDouble(),
+                    CordicTolerance<Q4_28>);
+        EXPECT_NEAR(std::atan2(-30000.0, 20000.0), FixedPointMath::Atan2(Q16_16(-30000.0), Q16_16(20000.0)).ToDouble(),
+                    CordicTolerance<Q16_16>);
+    }
+
+    TEST(FixedPointMath_Tests, ValidateExp)
+    {
+        static_assert(FixedPointMath::Exp(Q16_16(0.0)) == Q16_16(1.0));
+
+        for (double x = -12.0; x < std::log(Q16_16::GetMax()); x += 0.0071)
+        {
+            Q16_16 value(x);
+            double exact = std::exp(value.ToDouble());
+            ASSERT_NEAR(exact, FixedPointMath::Exp(value).ToDouble(),
+                        Q16_16::GetStepSize() / 2 + exact / (1 << 28))
+                << x;
+        }
+
+        for (double x = -7.9; x < std::log(Q4_28::GetMax()); x += 0.00071)
+        {
+            Q4_28  value(x);
+            double exact = std::exp(value.ToDouble());
+            ASSERT_NEAR(exact, FixedPointMath::Exp(value).ToDouble(), Q4_28::GetStepSize() / 2 + exact / (1 << 28))
+                << x;
+        }
+
+        EXPECT_EQ(Q16_16::MaxRawValue, FixedPointMath::Exp(Q16_16(10.4)).ToIntegral());
+        EXPECT_EQ(Q16_16::MaxRawValue, FixedPointMath::Exp(Q16_16(30000.0)).ToIntegral());
+        EXPECT_EQ(0, FixedPointMath::Exp(Q16_16(-30000.0)).ToIntegral());
+        EXPECT_EQ(1, FixedPointMath::Exp(Q16_16(-11.0)).ToIntegral());
+    }
+} // namespace Shared
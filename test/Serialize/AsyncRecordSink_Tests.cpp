@@ -0,0 +1,109 @@
+#include <Serialize/AsyncRecordSink.hpp>
+#include <Serialize/BinaryWriter.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+
+namespace Shared {
+    namespace {
+        std::vector<unsigned char> ReadAll(int fd)
+        {
+            std::vector<unsigned char> bytes;
+            unsigned char              chunk[4096];
+            ::lseek(fd, 0, SEEK_SET);
+            for (ssize_t numRead; (numRead = ::read(fd, chunk, sizeof(chunk))) > 0;)
+            {
+                bytes.insert(bytes.end(), chunk, chunk + numRead);
+            }
+            return bytes;
+        }
+    } // namespace
+
+    TEST(AsyncRecordSink_UnitTests, ValidateRecordsInOrder)
+    {
+        char path[] = "/tmp/AsyncRecordSink_TestsXXXXXX";
+        int  fd     = ::mkstemp(path);
+        ASSERT_GE(fd, 0);
+        ::unlink(path);
+
+        // Header written before the sink is created, records are appended after it.
+        ASSERT_EQ(4, ::write(fd, "HEAD", 4));
+
+        std::vector<unsigned char> expected({'H', 'E', 'A', 'D'});
+        {
+            AsyncRecordSink<> sink(fd, 2, 256, 3);
+            for (uint32_t i = 0; i < 1000; ++i)
+            {
+                auto buffer = sink.AcquireBuffer();
+                BinaryWriter<unsigned char*> writer(reinterpret_cast<unsigned char*>(buffer.Bytes.data()),
+                                                    reinterpret_cast<unsigned char*>(buffer.Bytes.data()) +
+                                                        buffer.Bytes.size());
+                writer.WriteNum(i);
+                std::vector<uint16_t> values(i % 50, static_cast<uint16_t>(i));
+                writer.WriteArrayNum(values.begin(), values.end(), LengthPrefix::Varint);
+                sink.Submit(buffer, writer.GetSize());
+
+                expected.insert(expected.end(), writer.GetBegin(), writer.GetBegin() + writer.GetSize());
+            }
+            EXPECT_LE(sink.GetInFlightCount(), 2);
+            sink.Flush();
+            EXPECT_EQ(0, sink.GetInFlightCount());
+
+            sink.Write(std::vector<std::byte>(3, std::byte('R')));
+            expected.insert(expected.end(), 3, 'R');
+        }
+
+        // The file position is past the last record once the sink is gone.
+        ASSERT_EQ(4, ::write(fd, "TAIL", 4));
+        expected.insert(expected.end(), {'T', 'A', 'I', 'L'});
+
+        EXPECT_EQ(expected, ReadAll(fd));
+        ::close(fd);
+    }
+
+    TEST(AsyncRecordSink_UnitTests, ValidateSynchronousFallback)
+    {
+        int pipeFds[2];
+        ASSERT_EQ(0, ::pipe(pipeFds));
+
+        std::vector<std::byte> record({std::byte(1), std::byte(2), std::byte(3)});
+        {
+            AsyncRecordSink<> sink(pipeFds[1], 2, 16);
+            EXPECT_FALSE(sink.IsAsync());
+            sink.Write(record);
+            sink.Write(record);
+            sink.Flush();
+        }
+        ::close(pipeFds[1]);
+
+        std::vector<unsigned char> bytes;
+        unsigned char              chunk[16];
+        for (ssize_t numRead; (numRead = ::read(pipeFds[0], chunk, sizeof(chunk))) > 0;)
+        {
+            bytes.insert(bytes.end(), chunk, chunk + numRead);
+        }
+        ::close(pipeFds[0]);
+
+        EXPECT_EQ(std::vector<unsigned char>({1, 2, 3, 1, 2, 3}), bytes);
+    }
+
+    TEST(AsyncRecordSink_UnitTests, ValidateWriteError)
+    {
+        AsyncRecordSink<> sink(-1, 1, 16);
+        EXPECT_THROW(sink.Write(std::vector<std::byte>(4)), std::runtime_error);
+
+        // Acquired buffers must be submitted before more can be handed out.
+        auto buffer = sink.AcquireBuffer();
+        EXPECT_THROW(sink.AcquireBuffer(), std::runtime_error);
+        sink.Submit(buffer, 0);
+    }
+} // namespace Shared
+#endif
@@ -0,0 +1,168 @@
+#include <Serialize/BinaryStream.hpp>
+#include <Serialize/BinaryWriter.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <list>
+#include <numeric>
+#include <vector>
+
+namespace Shared {
+    struct StreamTestRecord
+    {
+        uint32_t Id;
+        double   Value;
+    };
+
+    template <>
+    struct StructFields<StreamTestRecord> : FieldList<&StreamTestRecord::Id, &StreamTestRecord::Value> {
+    };
+
+    template <class WRITER>
+    void WriteStreamTestData(WRITER& writer, const std::vector<int32_t>& values)
+    {
+        const std::list<uint16_t> shortValues({1, 2, 3});
+
+        writer.WriteNum(uint8_t(0xAB));
+        writer.WriteNum(int64_t(-5));
+        writer.WriteArrayNum(values.begin(), values.end());
+        writer.WriteArrayNum(shortValues.begin(), shortValues.end(), LengthPrefix::Varint);
+        writer.WriteVarint(int32_t(-300));
+        writer.WriteVarintArray(values.begin(), values.begin() + 20);
+        writer.WriteStruct(StreamTestRecord{7, 0.5});
+        writer.WriteNum(float(2.25));
+    }
+
+    template <class READER>
+    void ValidateStreamTestData(READER& reader, const std::vector<int32_t>& values)
+    {
+        EXPECT_EQ(0xAB, reader.template ReadNum<uint8_t>());
+        EXPECT_EQ(-5, reader.template ReadNum<int64_t>());
+        EXPECT_EQ(values, reader.template ReadArrayNum<int32_t>());
+        EXPECT_EQ((std::vector<uint16_t>{1, 2, 3}), reader.template ReadArrayNum<uint16_t>(LengthPrefix::Varint));
+        EXPECT_EQ(-300, reader.template ReadVarint<int32_t>());
+        EXPECT_EQ(
+            std::vector<int32_t>(values.begin(), values.begin() + 20),
+            reader.template ReadVarintArray<int32_t>());
+
+        StreamTestRecord record = reader.template ReadStruct<StreamTestRecord>();
+        EXPECT_EQ(7, record.Id);
+        EXPECT_EQ(0.5, record.Value);
+        EXPECT_EQ(2.25, reader.template ReadNum<float>());
+    }
+
+    TEST(BinaryStream_UnitTests, ValidateMatchesBinaryWriter)
+    {
+        std::vector<int32_t> values(1000);
+        std::iota(values.begin(), values.end(), -500);
+
+        BinaryWriter<> expected;
+        WriteStreamTestData(expected, values);
+
+        std::vector<unsigned char> output;
+        size_t                     numFlushes{0};
+        {
+            BinaryStreamWriter<> writer(
+                [&](std::span<const std::byte> bytes) {
+                    ++numFlushes;
+                    EXPECT_LE(bytes.size(), 64);
+                    auto pBytes = reinterpret_cast<const unsigned char*>(bytes.data());
+                    output.insert(output.end(), pBytes, pBytes + bytes.size());
+                    return true;
+                },
+                64);
+            WriteStreamTestData(writer, values);
+            EXPECT_EQ(expected.GetSize(), writer.GetSize());
+            writer.Flush();
+            EXPECT_EQ(0, writer.GetBufferedSize());
+        }
+        EXPECT_GT(numFlushes, 60);
+        ASSERT_EQ(expected.GetSize(), output.size());
+        EXPECT_TRUE(std::equal(expected.GetBegin(), expected.GetEnd(), output.begin()));
+
+        // Hand the data back a few bytes at a time so values straddle refills.
+        size_t               readLoc{0};
+        BinaryStreamReader<> reader(
+            [&](std::span<std::byte> bytes) -> std::ptrdiff_t {
+                size_t count = std::min({bytes.size(), size_t(7), output.size() - readLoc});
+                std::memcpy(bytes.data(), output.data() + readLoc, count);
+                readLoc += count;
+                return count;
+            },
+            32);
+        ValidateStreamTestData(reader, values);
+        EXPECT_EQ(output.size(), reader.GetPosition());
+        EXPECT_TRUE(reader.AtEnd());
+        EXPECT_THROW(reader.ReadNum<uint8_t>(), std::runtime_error);
+    }
+
+    TEST(BinaryStream_UnitTests, ValidateLargeBlocks)
+    {
+        std::vector<std::byte> block(1000);
+        for (size_t i = 0; i < block.size(); ++i)
+        {
+            block[i] = static_cast<std::byte>(i * 7);
+        }
+
+        std::vector<std::byte> output;
+        BinaryStreamWriter<>   writer(
+            [&](std::span<const std::byte> bytes) {
+                output.insert(output.end(), bytes.begin(), bytes.end());
+                return true;
+            },
+            16);
+        writer.WriteNum(uint16_t(1));
+        writer.WriteBytes(block);
+        writer.WriteNum(uint16_t(2));
+        writer.Flush();
+        ASSERT_EQ(block.size() + 4, output.size());
+
+        size_t               readLoc{0};
+        BinaryStreamReader<> reader(
+            [&](std::span<std::byte> bytes) -> std::ptrdiff_t {
+                size_t count = std::min(bytes.size(), output.size() - readLoc);
+                std::memcpy(bytes.data(), output.data() + readLoc, count);
+                readLoc += count;
+                return count;
+            },
+            16);
+        EXPECT_EQ(1, reader.ReadNum<uint16_t>());
+        std::vector<std::byte> readBlock(block.size());
+        reader.ReadBytes(readBlock);
+        EXPECT_EQ(block, readBlock);
+        EXPECT_EQ(2, reader.ReadNum<uint16_t>());
+        EXPECT_TRUE(reader.AtEnd());
+
+        BinaryStreamWriter<> failingWriter([](std::span<const std::byte>) { return false; }, 16);
+        failingWriter.WriteNum(uint64_t(1));
+        EXPECT_THROW(failingWriter.Flush(), std::runtime_error);
+    }
+
+#if defined(__unix__) || defined(__APPLE__)
+    TEST(BinaryStream_UnitTests, ValidateFileDescriptor)
+    {
+        std::vector<int32_t> values(5000);
+        std::iota(values.begin(), values.end(), 0);
+
+        std::FILE* pFile = std::tmpfile();
+        ASSERT_NE(nullptr, pFile);
+        int fd = fileno(pFile);
+
+        {
+            BinaryStreamWriter<> writer(FileDescriptorSink(fd), 256);
+            WriteStreamTestData(writer, values);
+        }
+
+        ASSERT_EQ(0, ::lseek(fd, 0, SEEK_SET));
+        BinaryStreamReader<> reader(FileDescriptorSource(fd), 256);
+        ValidateStreamTestData(reader, values);
+        EXPECT_TRUE(reader.AtEnd());
+
+        std::fclose(pFile);
+    }
+#endif
+} // namespace Shared
@@ -3,6 +3,11 @@
 
 #include <gtest/gtest.h>
 
+#include <array>
+#include <deque>
+#include <limits>
+#include <list>
+
 namespace Shared {
     TEST(BinaryWriter_UnitTests, ValidateBasicReadWrite)
     {
@@ -34,6 +39,7 @@ namespace Shared {
         EXPECT_EQ(initVal2, val2);
         EXPECT_EQ(initVal3, val3);
         EXPECT_EQ(initVal4, val4);
+        EXPECT_EQ(initVal5, val5);
 
         EXPECT_EQ(expectedSize, writer.GetSize());
 
@@ -73,4 +79,286 @@ namespace Shared {
         writer.Clear();
         EXPECT_EQ(memBuffer.size(), writer.GetSize());
     }
-} // namespace Shared
\ No newline at end of file
+
+    TEST(BinaryWriter_UnitTests, ValidateGeometricGrowth)
+    {
+        BinaryWriter writer;
+        EXPECT_EQ(0, writer.GetSize());
+        EXPECT_EQ(0, writer.Capacity());
+
+        size_t reallocations{0};
+        size_t lastCapacity{writer.Capacity()};
+        for (int i = 0; i < 1000; ++i)
+        {
+            writer.WriteNum(i);
+            EXPECT_EQ((i + 1) * sizeof(int), writer.GetSize());
+            EXPECT_GE(writer.Capacity(), writer.GetSize());
+            if (writer.Capacity() != lastCapacity)
+            {
+                ++reallocations;
+                lastCapacity = writer.Capacity();
+            }
+        }
+        EXPECT_LE(reallocations, 12);
+
+        writer.Reset();
+        for (int i = 0; i < 1000; ++i)
+        {
+            ASSERT_EQ(i, writer.ReadNum<int>());
+        }
+        ASSERT_THROW(writer.ReadNum<int>(), std::runtime_error);
+
+        // Overwriting existing data does not change the written size.
+        writer.SetLoc(sizeof(int));
+        writer.WriteNum(int(-1));
+        EXPECT_EQ(1000 * sizeof(int), writer.GetSize());
+        writer.SetLoc(sizeof(int));
+        EXPECT_EQ(-1, writer.ReadNum<int>());
+
+        size_t capacity{writer.Capacity()};
+        writer.Clear();
+        EXPECT_EQ(0, writer.GetSize());
+        EXPECT_EQ(capacity, writer.Capacity());
+    }
+
+    TEST(BinaryWriter_UnitTests, ValidateReserve)
+    {
+        BinaryWriter writer(16);
+        EXPECT_EQ(0, writer.GetSize());
+        EXPECT_EQ(16, writer.Capacity());
+        ASSERT_THROW(writer.ReadNum<int>(), std::runtime_error);
+
+        writer.Reserve(100 * sizeof(double));
+        EXPECT_EQ(100 * sizeof(double), writer.Capacity());
+        EXPECT_EQ(0, writer.GetSize());
+
+        auto begin = writer.GetBegin();
+        for (int i = 0; i < 100; ++i)
+        {
+            writer.WriteNum(double(i));
+        }
+        EXPECT_EQ(begin, writer.GetBegin());
+        EXPECT_EQ(100 * sizeof(double), writer.GetSize());
+
+        std::vector<unsigned char> memBuffer(16, 0x00);
+        BinaryWriter               external(memBuffer.begin(), memBuffer.end());
+        EXPECT_EQ(memBuffer.size(), external.Capacity());
+        EXPECT_NO_THROW(external.Reserve(8));
+        ASSERT_THROW(external.Reserve(32), std::invalid_argument);
+    }
+
+    TEST(BinaryWriter_UnitTests, ValidateBulkArrayMatchesScalar)
+    {
+        const std::vector<double> contiguous({1.5, -.002, 0.0, 1e300, -1e-300, 42.0});
+        const std::list<double>   nonContiguous(contiguous.begin(), contiguous.end());
+
+        BinaryWriter bulkWriter;
+        bulkWriter.WriteArrayNum(contiguous.begin(), contiguous.end());
+
+        BinaryWriter scalarWriter;
+        scalarWriter.WriteArrayNum(nonContiguous.begin(), nonContiguous.end());
+
+        ASSERT_EQ(sizeof(size_t) + contiguous.size() * sizeof(double), bulkWriter.GetSize());
+        EXPECT_TRUE(std::equal(
+            bulkWriter.GetBegin(),
+            bulkWriter.GetEnd(),
+            scalarWriter.GetBegin(),
+            scalarWriter.GetEnd()));
+
+        bulkWriter.Reset();
+        EXPECT_EQ(contiguous, bulkWriter.ReadArrayNum<double>());
+
+        std::array<unsigned char, 64> memBuffer{};
+        BinaryWriter<unsigned char*>  pointerWriter(memBuffer.data(), memBuffer.data() + memBuffer.size());
+        const std::array<uint16_t, 4> shorts{0x0102, 0x0304, 0x0506, 0x0708};
+        pointerWriter.WriteArrayNum(shorts.begin(), shorts.end());
+        pointerWriter.Reset();
+        std::vector<uint16_t> readShorts(pointerWriter.ReadArrayNum<uint16_t>());
+        EXPECT_TRUE(std::equal(shorts.begin(), shorts.end(), readShorts.begin(), readShorts.end()));
+        EXPECT_EQ(0x02, memBuffer[sizeof(size_t)]);
+        EXPECT_EQ(0x01, memBuffer[sizeof(size_t) + 1]);
+    }
+
+    TEST(BinaryWriter_UnitTests, ValidateReadViews)
+    {
+        const std::vector<int>       values({1, -2, 3, -4, 5, 6});
+        const std::vector<std::byte> rawBytes({std::byte{0xDE}, std::byte{0xAD}, std::byte{0xBE}, std::byte{0xEF}});
+
+        BinaryWriter writer;
+        writer.WriteArrayNum(values.begin(), values.end());
+        writer.WriteBytes(rawBytes);
+        writer.WriteNum(7);
+
+        writer.Reset();
+        ArithmaticArrayView<int> view = writer.ReadArrayView<int>();
+        ASSERT_EQ(values.size(), view.size());
+        EXPECT_TRUE(std::equal(values.begin(), values.end(), view.begin(), view.end()));
+        EXPECT_EQ(-4, view[3]);
+        EXPECT_EQ(values.back(), *(view.end() - 1));
+        EXPECT_EQ(
+            reinterpret_cast<const std::byte*>(&*writer.GetBegin()) + sizeof(size_t),
+            view.GetBytes().data());
+
+        std::span<const std::byte> bytes = writer.ReadBytes(rawBytes.size());
+        EXPECT_TRUE(std::equal(rawBytes.begin(), rawBytes.end(), bytes.begin(), bytes.end()));
+        EXPECT_EQ(7, writer.ReadNum<int>());
+        ASSERT_THROW(writer.ReadBytes(1), std::runtime_error);
+
+        static_assert(std::ranges::random_access_range<ArithmaticArrayView<double>>);
+    }
+
+    TEST(BinaryWriter_UnitTests, ValidateVarint)
+    {
+        BinaryWriter writer;
+        writer.WriteVarint(uint32_t(1));
+        writer.WriteVarint(int64_t(-1));
+        writer.WriteVarint(uint16_t(300));
+        writer.WriteVarint(std::numeric_limits<int64_t>::min());
+        EXPECT_EQ(1 + 1 + 2 + 10, writer.GetSize());
+
+        const std::vector<short> values({1, -2, 3, -4, 5});
+        writer.WriteArrayNum(values.begin(), values.end(), LengthPrefix::Varint);
+        EXPECT_EQ(14 + 1 + values.size() * sizeof(short), writer.GetSize());
+
+        std::vector<int> deltas;
+        for (int i = 0; i < 200; ++i)
+        {
+            deltas.push_back(i % 3 == 0 ? -i : i * 1000);
+        }
+        size_t sizeBefore = writer.GetSize();
+        writer.WriteVarintArray(deltas.begin(), deltas.end());
+        EXPECT_LT(writer.GetSize() - sizeBefore, deltas.size() * sizeof(int));
+
+        writer.Reset();
+        EXPECT_EQ(1, writer.ReadVarint<uint32_t>());
+        EXPECT_EQ(-1, writer.ReadVarint<int64_t>());
+        EXPECT_EQ(300, writer.ReadVarint<uint16_t>());
+        EXPECT_EQ(std::numeric_limits<int64_t>::min(), writer.ReadVarint<int64_t>());
+        EXPECT_EQ(values, writer.ReadArrayNum<short>(LengthPrefix::Varint));
+        EXPECT_EQ(deltas, writer.ReadVarintArray<int>());
+        ASSERT_THROW(writer.ReadVarint<int>(), std::runtime_error);
+
+        writer.Reset();
+        writer.ReadVarint<uint32_t>();
+        writer.ReadVarint<int64_t>();
+        ASSERT_THROW(writer.ReadVarint<uint8_t>(), std::runtime_error);
+    }
+
+    TEST(BinaryWriter_UnitTests, ValidateBigEndian)
+    {
+        BigEndianBinaryWriter writer;
+        writer.WriteNum(uint16_t(0x0102));
+        writer.WriteNum(uint32_t(0x03040506));
+        writer.WriteNum(float(1.5));
+
+        const std::vector<uint16_t> values({0x0708, 0x090A});
+        writer.WriteArrayNum(values.begin(), values.end());
+
+        const std::vector<unsigned char> expected({
+            0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x3F, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x02, 0x07, 0x08, 0x09, 0x0A});
+        ASSERT_EQ(expected.size(), writer.GetSize());
+        EXPECT_TRUE(std::equal(expected.begin(), expected.end(), writer.GetBegin(), writer.GetEnd()));
+
+        writer.Reset();
+        EXPECT_EQ(0x0102, writer.ReadNum<uint16_t>());
+        EXPECT_EQ(0x03040506, writer.ReadNum<uint32_t>());
+        EXPECT_EQ(1.5, writer.ReadNum<float>());
+        EXPECT_EQ(values, writer.ReadArrayNum<uint16_t>());
+
+        writer.SetLoc(10);
+        auto view = writer.ReadArrayView<uint16_t>();
+        EXPECT_TRUE(std::equal(values.begin(), values.end(), view.begin(), view.end()));
+
+        // Non-contiguous buffers take the per-element path and must produce the same bytes.
+        typedef BinaryWriter<std::deque<unsigned char>::iterator, true, Endianess::BigEndian> DequeWriter;
+
+        std::deque<unsigned char> dequeBuffer(expected.size());
+        DequeWriter               dequeWriter(dequeBuffer.begin(), dequeBuffer.end());
+        dequeWriter.WriteNum(uint16_t(0x0102));
+        dequeWriter.WriteNum(uint32_t(0x03040506));
+        dequeWriter.WriteNum(float(1.5));
+        dequeWriter.WriteArrayNum(values.begin(), values.end());
+        EXPECT_TRUE(std::equal(expected.begin(), expected.end(), dequeBuffer.begin(), dequeBuffer.end()));
+
+        dequeWriter.Reset();
+        EXPECT_EQ(0x0102, dequeWriter.ReadNum<uint16_t>());
+        dequeWriter.SetLoc(10);
+        EXPECT_EQ(values, dequeWriter.ReadArrayNum<uint16_t>());
+    }
+
+    TEST(BinaryWriter_UnitTests, ValidateWriteTransaction)
+    {
+        const std::vector<int32_t>     values({1, -2, 3, -4, 5});
+        const std::array<std::byte, 3> bytes({std::byte(7), std::byte(8), std::byte(9)});
+
+        BinaryWriter<> expected;
+        expected.WriteNum(uint16_t(0xBEEF));
+        expected.WriteArrayNum(values.begin(), values.end(), LengthPrefix::Varint);
+        expected.WriteBytes(bytes);
+        expected.WriteNum(double(2.5));
+
+        const size_t blockSize =
+            sizeof(uint16_t) + BinaryWriter<>::GetArrayNumSize<int32_t>(values.size(), LengthPrefix::Varint) +
+            bytes.size() + sizeof(double);
+        ASSERT_EQ(expected.GetSize(), blockSize);
+
+        BinaryWriter<> writer;
+        {
+            auto transaction = writer.BeginWrite(blockSize);
+            EXPECT_EQ(blockSize, transaction.Remaining());
+            transaction.WriteNum(uint16_t(0xBEEF));
+            transaction.WriteArrayNum(values.begin(), values.end(), LengthPrefix::Varint);
+            transaction.WriteBytes(bytes);
+            transaction.WriteNum(double(2.5));
+            EXPECT_EQ(0, transaction.Remaining());
+        }
+        ASSERT_EQ(blockSize, writer.GetSize());
+        EXPECT_TRUE(std::equal(expected.GetBegin(), expected.GetEnd(), writer.GetBegin(), writer.GetEnd()));
+
+        writer.Reset();
+        {
+            auto transaction = writer.BeginRead(sizeof(uint16_t));
+            EXPECT_EQ(0xBEEF, transaction.ReadNum<uint16_t>());
+        }
+        EXPECT_EQ(values, writer.ReadArrayNum<int32_t>(LengthPrefix::Varint));
+        writer.ReadBytes(bytes.size());
+        EXPECT_EQ(2.5, writer.BeginRead(sizeof(double)).ReadNum<double>());
+        EXPECT_THROW(writer.BeginRead(1), std::runtime_error);
+
+        // The single up-front check still rejects blocks that do not fit external storage.
+        std::vector<unsigned char> buffer(8);
+        BinaryWriter<>             external(buffer.begin(), buffer.end());
+        EXPECT_THROW(external.BeginWrite(9), std::runtime_error);
+        EXPECT_NO_THROW(external.BeginWrite(8));
+    }
+
+    TEST(BinaryWriter_UnitTests, ValidateUncheckedBounds)
+    {
+        typedef BinaryWriter<std::vector<unsigned char>::iterator, true, Endianess::LittleEndian, UncheckedBounds>
+            UncheckedWriter;
+
+        UncheckedWriter writer;
+        writer.Reserve(64);
+        for (uint32_t i = 0; i < 16; ++i)
+        {
+            writer.WriteNum(i);
+        }
+        EXPECT_EQ(64, writer.GetSize());
+        EXPECT_EQ(64, writer.Capacity());
+
+        writer.Reset();
+        for (uint32_t i = 0; i < 16; ++i)
+        {
+            ASSERT_EQ(i, writer.ReadNum<uint32_t>());
+        }
+
+        typedef BinaryWriter<unsigned char*, false, Endianess::BigEndian, UncheckedBounds> UncheckedPtrWriter;
+
+        std::array<unsigned char, 6> buffer{};
+        UncheckedPtrWriter           ptrWriter(buffer.data(), buffer.data() + buffer.size());
+        ptrWriter.WriteNum(uint16_t(0x0102));
+        ptrWriter.WriteNum(uint32_t(0x03040506));
+        EXPECT_EQ((std::array<unsigned char, 6>{1, 2, 3, 4, 5, 6}), buffer);
+    }
+} // namespace Shared
@@ -0,0 +1,130 @@
+#include <Serialize/BitStream.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace Shared {
+    enum class BitStreamTestMode
+    {
+        Off = 2,
+        Low,
+        Medium,
+        High,
+    };
+
+    class BitStreamTestModeEnum
+        : public Enum<BitStreamTestMode, BitStreamTestMode::Off, BitStreamTestMode::High, int, BitStreamTestModeEnum> {
+      public:
+        BitStreamTestModeEnum()
+            : Enum()
+        {
+        }
+        BitStreamTestModeEnum(BitStreamTestMode value)
+            : Enum(value)
+        {
+        }
+    };
+
+    enum class BitStreamTestFlags
+    {
+        A,
+        B,
+        C,
+    };
+
+    TEST(BitStream_UnitTests, ValidateFieldRoundTrip)
+    {
+        const std::vector<size_t> widths({3, 5, 12, 1, 64, 7, 33, 64, 2});
+
+        std::vector<uint64_t> values;
+        BitWriter             writer;
+        for (size_t i = 0; i < 100; ++i)
+        {
+            size_t   width = widths[i % widths.size()];
+            uint64_t value = (0x9E3779B97F4A7C15ull * (i + 1)) & LowBitMask(width);
+            values.push_back(value);
+            writer.WriteBits(value, width);
+        }
+        writer.WriteSignedBits(-5, 4);
+        writer.WriteBool(true);
+        size_t numBits = writer.GetBitSize();
+        auto   bytes   = writer.Flush();
+        EXPECT_EQ((numBits + 7) / 8, bytes.size());
+
+        BitReader<> reader(bytes);
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            EXPECT_EQ(values[i], reader.ReadBits(widths[i % widths.size()]));
+        }
+        EXPECT_EQ(-5, reader.ReadSignedBits(4));
+        EXPECT_TRUE(reader.ReadBool());
+        EXPECT_EQ(numBits, reader.GetBitPosition());
+
+        reader.AlignToByte();
+        EXPECT_EQ(0, reader.GetRemainingBits());
+        EXPECT_THROW(reader.ReadBits(1), std::runtime_error);
+    }
+
+    TEST(BitStream_UnitTests, ValidatePackedLayout)
+    {
+        BitWriter writer;
+        writer.WriteBits(0b101, 3);
+        writer.WriteBits(0b11001, 5);
+        writer.WriteBits(0xABC, 12);
+        auto bytes = writer.Flush();
+
+        ASSERT_EQ(3, bytes.size());
+        EXPECT_EQ(std::byte(0b11001101), bytes[0]);
+        EXPECT_EQ(std::byte(0xBC), bytes[1]);
+        EXPECT_EQ(std::byte(0x0A), bytes[2]);
+    }
+
+    TEST(BitStream_UnitTests, ValidateTypedFields)
+    {
+        typedef BitSetTemplate<BitStreamTestFlags, uint16_t, 0x0005> flagsType;
+        typedef FixedPoint<int16_t, 6, 6>                            temperatureType;
+        typedef FixedPoint<uint8_t, 4, 3>                            levelType;
+
+        EXPECT_EQ(2, EnumBitWidth(static_cast<const BitStreamTestModeEnum*>(nullptr)));
+        EXPECT_EQ(3, BitSetBitWidth(static_cast<const flagsType*>(nullptr)));
+
+        BitWriter writer;
+        writer.Write(BitStreamTestModeEnum(BitStreamTestMode::High));
+        writer.Write(flagsType(0x0004));
+        writer.Write(temperatureType(-12.5));
+        writer.Write(levelType(9.625));
+        EXPECT_EQ(2 + 3 + 12 + 7, writer.GetBitSize());
+        auto bytes = writer.Flush();
+        EXPECT_EQ(3, bytes.size());
+
+        BitStreamTestModeEnum mode;
+        flagsType             flags(0);
+        temperatureType       temperature;
+        levelType             level;
+
+        BitReader<> reader(bytes);
+        reader.Read(mode);
+        reader.Read(flags);
+        reader.Read(temperature);
+        reader.Read(level);
+
+        EXPECT_EQ(BitStreamTestMode::High, mode.ToEnum());
+        EXPECT_EQ(0x0004, flags.GetRawValue());
+        EXPECT_DOUBLE_EQ(-12.5, temperature.ToDouble());
+        EXPECT_DOUBLE_EQ(9.625, level.ToDouble());
+    }
+
+    TEST(BitStream_UnitTests, ValidateInvalidValues)
+    {
+        BitWriter writer;
+        writer.WriteBits(0b10, 3);
+        auto bytes = writer.Flush();
+
+        BitReader<> reader(bytes);
+        BitSetTemplate<BitStreamTestFlags, uint8_t, 0x05> flags(0);
+        EXPECT_THROW(reader.Read(flags), std::invalid_argument);
+    }
+} // namespace Shared
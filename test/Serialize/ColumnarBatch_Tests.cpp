@@ -0,0 +1,170 @@
+#include <Serialize/BinaryWriter.hpp>
+#include <Serialize/ColumnarBatch.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace Shared {
+    struct ColumnarTestSample
+    {
+        uint32_t SensorId;
+        int64_t  Timestamp;
+        double   Value;
+        int16_t  Delta;
+    };
+
+    template <>
+    struct StructFields<ColumnarTestSample>
+        : FieldList<
+              &ColumnarTestSample::SensorId,
+              &ColumnarTestSample::Timestamp,
+              &ColumnarTestSample::Value,
+              &ColumnarTestSample::Delta> {
+    };
+
+    bool operator==(const ColumnarTestSample& lhs, const ColumnarTestSample& rhs)
+    {
+        return lhs.SensorId == rhs.SensorId && lhs.Timestamp == rhs.Timestamp && lhs.Value == rhs.Value &&
+               lhs.Delta == rhs.Delta;
+    }
+
+    enum class ColumnarTestFlag
+    {
+        Valid,
+        Calibrated,
+        Saturated
+    };
+
+    struct ColumnarTestEvent
+    {
+        uint32_t                                        Id;
+        BitSetTemplate<ColumnarTestFlag, uint8_t, 0x07> Flags{0};
+    };
+
+    template <>
+    struct StructFields<ColumnarTestEvent> : FieldList<&ColumnarTestEvent::Id, &ColumnarTestEvent::Flags> {
+    };
+
+    namespace {
+        std::vector<ColumnarTestSample> ColumnarTestSamples(size_t count)
+        {
+            std::vector<ColumnarTestSample> samples;
+            for (size_t i = 0; i < count; ++i)
+            {
+                samples.push_back(ColumnarTestSample{static_cast<uint32_t>(i % 4),
+                                                     1700000000000 + static_cast<int64_t>(i) * 250,
+                                                     static_cast<double>(i) * 0.5,
+                                                     static_cast<int16_t>(i % 2 == 0 ? -32768 : 32767)});
+            }
+            return samples;
+        }
+    } // namespace
+
+    TEST(ColumnarBatch_UnitTests, ValidateRawColumns)
+    {
+        const std::vector<ColumnarTestSample> samples = ColumnarTestSamples(100);
+
+        BinaryWriter<> writer;
+        ColumnarBatchWriter<ColumnarTestSample>().Write(writer, std::span<const ColumnarTestSample>(samples));
+        writer.WriteNum(uint8_t(0x5A));
+        writer.Reset();
+
+        ColumnarBatchReader<ColumnarTestSample> reader;
+        reader.Read(writer);
+        EXPECT_EQ(0x5A, writer.ReadNum<uint8_t>());
+        EXPECT_EQ(samples.size(), reader.GetRowCount());
+        EXPECT_EQ(ColumnEncoding::Raw, reader.GetEncoding<&ColumnarTestSample::Value>());
+
+        std::vector<double> values = reader.ReadColumn<&ColumnarTestSample::Value>();
+        for (size_t i = 0; i < samples.size(); ++i)
+        {
+            EXPECT_EQ(samples[i].Value, values[i]);
+        }
+        EXPECT_EQ(samples, reader.ReadRecords());
+    }
+
+    TEST(ColumnarBatch_UnitTests, ValidateVarintColumns)
+    {
+        typedef ColumnarBatchWriter<ColumnarTestSample, true, Endianess::BigEndian> writerType;
+
+        const std::vector<ColumnarTestSample> samples = ColumnarTestSamples(1000);
+
+        writerType::encodingsType encodings{};
+        writerType::SetEncoding<&ColumnarTestSample::SensorId>(encodings, ColumnEncoding::Varint);
+        writerType::SetEncoding<&ColumnarTestSample::Timestamp>(encodings, ColumnEncoding::DeltaVarint);
+        writerType::SetEncoding<&ColumnarTestSample::Delta>(encodings, ColumnEncoding::DeltaVarint);
+
+        BinaryWriter<> raw;
+        ColumnarBatchWriter<ColumnarTestSample>().Write(raw, std::span<const ColumnarTestSample>(samples));
+
+        BinaryWriter<> writer;
+        writerType(encodings).Write(writer, std::span<const ColumnarTestSample>(samples));
+        EXPECT_LT(writer.GetSize() * 3, raw.GetSize() * 2);
+        writer.Reset();
+
+        ColumnarBatchReader<ColumnarTestSample, true, Endianess::BigEndian> reader;
+        reader.Read(writer);
+        EXPECT_EQ(ColumnEncoding::DeltaVarint, reader.GetEncoding<&ColumnarTestSample::Timestamp>());
+
+        std::vector<int64_t> timestamps(samples.size());
+        reader.ReadColumn<&ColumnarTestSample::Timestamp>(timestamps.data());
+        for (size_t i = 0; i < samples.size(); ++i)
+        {
+            EXPECT_EQ(samples[i].Timestamp, timestamps[i]);
+        }
+        EXPECT_EQ(samples, reader.ReadRecords());
+    }
+
+    TEST(ColumnarBatch_UnitTests, ValidateBitSetColumns)
+    {
+        std::vector<ColumnarTestEvent> events(20);
+        for (uint32_t i = 0; i < events.size(); ++i)
+        {
+            events[i].Id = i;
+            events[i].Flags.SetViaID(ColumnarTestFlag::Valid, true);
+            events[i].Flags.SetViaID(ColumnarTestFlag::Saturated, i % 3 == 0);
+        }
+
+        BinaryWriter<> writer;
+        ColumnarBatchWriter<ColumnarTestEvent>().Write(writer, std::span<const ColumnarTestEvent>(events));
+        writer.Reset();
+
+        ColumnarBatchReader<ColumnarTestEvent> reader;
+        reader.Read(writer);
+
+        auto flags   = reader.ReadColumn<&ColumnarTestEvent::Flags>();
+        auto records = reader.ReadRecords();
+        ASSERT_EQ(events.size(), flags.size());
+        ASSERT_EQ(events.size(), records.size());
+        for (size_t i = 0; i < events.size(); ++i)
+        {
+            EXPECT_EQ(events[i].Flags.GetRawValue(), flags[i].GetRawValue());
+            EXPECT_EQ(events[i].Id, records[i].Id);
+            EXPECT_EQ(events[i].Flags.GetRawValue(), records[i].Flags.GetRawValue());
+        }
+    }
+
+    TEST(ColumnarBatch_UnitTests, ValidateInvalidBatches)
+    {
+        ColumnarBatchWriter<ColumnarTestSample>::encodingsType encodings{};
+        ColumnarBatchWriter<ColumnarTestSample>::SetEncoding<&ColumnarTestSample::Value>(encodings,
+                                                                                         ColumnEncoding::Varint);
+        EXPECT_THROW(ColumnarBatchWriter<ColumnarTestSample>{encodings}, std::invalid_argument);
+
+        const std::vector<ColumnarTestSample> samples = ColumnarTestSamples(10);
+
+        BinaryWriter<> writer;
+        ColumnarBatchWriter<ColumnarTestSample>().Write(writer, std::span<const ColumnarTestSample>(samples));
+
+        // Claim one more row than the raw columns hold.
+        std::vector<unsigned char> bytes(writer.GetBegin(), writer.GetBegin() + writer.GetSize());
+        bytes[0] = 11;
+        BinaryWriter<> corrupt(bytes.begin(), bytes.end());
+
+        ColumnarBatchReader<ColumnarTestSample> reader;
+        EXPECT_THROW(reader.Read(corrupt), std::runtime_error);
+    }
+} // namespace Shared
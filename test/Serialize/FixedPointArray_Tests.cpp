@@ -0,0 +1,114 @@
+#include <Serialize/FixedPointArray.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace Shared {
+    namespace {
+        /**
+         * Values within the range of FIXED_TYPE, including exact halves of a step to check the rounding.
+         */
+        template <class FIXED_TYPE, class FLOAT_TYPE>
+        std::vector<FLOAT_TYPE> makeInRangeValues(size_t count)
+        {
+            std::mt19937                           generator(42);
+            std::uniform_real_distribution<double> distribution(FIXED_TYPE::GetMin(), FIXED_TYPE::GetMax());
+
+            std::vector<FLOAT_TYPE> values(count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                double value = distribution(generator);
+                if (i % 3 == 0)
+                {
+                    value = (std::trunc(value / FIXED_TYPE::GetStepSize()) + 0.5) * FIXED_TYPE::GetStepSize();
+                }
+                values[i] = static_cast<FLOAT_TYPE>(std::clamp(value, FIXED_TYPE::GetMin(), FIXED_TYPE::GetMax()));
+            }
+            return values;
+        }
+
+        template <class FIXED_TYPE, class FLOAT_TYPE>
+        void validateRoundTrip(size_t count)
+        {
+            typedef FixedPointArray<FIXED_TYPE> arrayType;
+
+            std::vector<FLOAT_TYPE> values = makeInRangeValues<FIXED_TYPE, FLOAT_TYPE>(count);
+            std::vector<FIXED_TYPE> fixedValues(count);
+            EXPECT_EQ(0, arrayType::Quantize(values.data(), count, fixedValues.data()));
+
+            std::vector<FLOAT_TYPE> restored(count);
+            arrayType::Dequantize(fixedValues.data(), count, restored.data());
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                FIXED_TYPE expected(static_cast<double>(values[i]));
+                ASSERT_EQ(expected.ToIntegral(), fixedValues[i].ToIntegral()) << "index " << i;
+                ASSERT_EQ(static_cast<FLOAT_TYPE>(expected.ToDouble()), restored[i]) << "index " << i;
+            }
+        }
+    } // namespace
+
+    TEST(FixedPointArray_UnitTests, MatchesElementWiseConversion)
+    {
+        // 67 values cover full blocks of 8 and a scalar tail.
+        validateRoundTrip<FixedPoint<int16_t, 8, 8>, double>(67);
+        validateRoundTrip<FixedPoint<int16_t, 8, 8>, float>(67);
+        validateRoundTrip<FixedPoint<uint16_t, 4, 12>, double>(67);
+        validateRoundTrip<FixedPoint<int8_t, 4, 4>, double>(67);
+        validateRoundTrip<FixedPoint<uint8_t, 2, 5>, float>(67);
+        validateRoundTrip<FixedPoint<int32_t, 16, 16>, double>(67);
+        validateRoundTrip<FixedPoint<uint32_t, 12, 12>, float>(67);
+        validateRoundTrip<FixedPoint<uint32_t, 16, 16>, double>(67);
+        validateRoundTrip<FixedPoint<int16_t, 6, 6>, double>(5);
+        validateRoundTrip<FixedPoint<int64_t, 40, 24>, double>(67);
+        validateRoundTrip<FixedPoint<uint64_t, 32, 32>, float>(67);
+    }
+
+    TEST(FixedPointArray_UnitTests, SaturatesOutOfRangeValues)
+    {
+        typedef FixedPoint<int16_t, 8, 8>   signedType;
+        typedef FixedPoint<uint16_t, 8, 8>  unsignedType;
+        typedef FixedPointArray<signedType> signedArrayType;
+
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        const double inf = std::numeric_limits<double>::infinity();
+
+        std::vector<double> values{1000.0, -1000.0, nan, inf, -inf, 127.99, -127.99, 0.5, 1.0, -1.0, 1e300, -0.0};
+        std::vector<int16_t> rawValues(values.size());
+        EXPECT_EQ(6, signedArrayType::Quantize(values.data(), values.size(), rawValues.data()));
+
+        std::vector<int16_t> expected{signedType::MaxRawValue,
+                                      signedType::MinRawValue,
+                                      signedType::MinRawValue,
+                                      signedType::MaxRawValue,
+                                      signedType::MinRawValue,
+                                      signedType(127.99).ToIntegral(),
+                                      signedType(-127.99).ToIntegral(),
+                                      128,
+                                      256,
+                                      -256,
+                                      signedType::MaxRawValue,
+                                      0};
+        EXPECT_EQ(expected, rawValues);
+
+        // The same values in the scalar tail.
+        EXPECT_EQ(1, signedArrayType::Quantize(values.data() + 8, 4, rawValues.data()));
+        EXPECT_EQ(256, rawValues[0]);
+        EXPECT_EQ(-256, rawValues[1]);
+        EXPECT_EQ(signedType::MaxRawValue, rawValues[2]);
+        EXPECT_EQ(2, signedArrayType::Quantize(values.data(), 2, rawValues.data()));
+        EXPECT_EQ(signedType::MaxRawValue, rawValues[0]);
+        EXPECT_EQ(signedType::MinRawValue, rawValues[1]);
+
+        std::vector<float>    negative(16, -0.25f);
+        std::vector<uint16_t> unsignedValues(negative.size());
+        EXPECT_EQ(16, FixedPointArray<unsignedType>::Quantize(negative.data(), negative.size(), unsignedValues.data()));
+        EXPECT_EQ(std::vector<uint16_t>(16, 0), unsignedValues);
+    }
+} // namespace Shared
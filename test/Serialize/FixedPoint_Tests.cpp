@@ -2,6 +2,9 @@
 
 #include <gtest/gtest.h>
 
+#include <array>
+#include <cstdint>
+#include <limits>
 #include <variant>
 
 namespace Shared {
@@ -24,6 +27,9 @@ namespace Shared {
 
         EXPECT_THROW(U16_8Value = (double)-1.0, std::out_of_range);
         EXPECT_THROW(U16_8Value = (double)1000.0, std::out_of_range);
+        EXPECT_THROW(U16_8Value = std::numeric_limits<double>::quiet_NaN(), std::out_of_range);
+        EXPECT_THROW((FixedPoint<int16_t, 8, 8>(-std::numeric_limits<double>::quiet_NaN())), std::out_of_range);
+        EXPECT_EQ(1, U16_8Value.ToIntegral());
     }
 
     TEST(FixedPoint_UnitTests, StaticMethods)
@@ -98,4 +104,136 @@ namespace Shared {
         truncatedValue = Shared::FixedPoint<short, 16, 0>::Truncate(1.45);
         EXPECT_DOUBLE_EQ(1.0, truncatedValue);
     }
+    TEST(FixedPoint_UnitTests, ValidateStorage)
+    {
+        typedef Shared::FixedPoint<int16_t, 8, 8> fixedType;
+
+        static_assert(sizeof(fixedType) == sizeof(int16_t));
+        static_assert(sizeof(std::array<fixedType, 100>) == 100 * sizeof(int16_t));
+        static_assert(std::is_trivially_copyable<fixedType>::value);
+
+        EXPECT_EQ(-384, fixedType(-1.5).ToIntegral());
+        EXPECT_EQ(-385, fixedType(-1.5 - 0.75 / 256).ToIntegral());
+        EXPECT_DOUBLE_EQ(-1.5, fixedType::FromRaw(-384).ToDouble());
+    }
+
+    TEST(FixedPoint_UnitTests, ValidateArithmetic)
+    {
+        typedef Shared::FixedPoint<int16_t, 8, 8> fixedType;
+
+        // Everything is usable at compile time.
+        constexpr fixedType a(2.5);
+        constexpr fixedType b(-1.25);
+        static_assert((a + b).ToIntegral() == 320);
+        static_assert((a - b).ToIntegral() == 960);
+        static_assert((a * b).ToIntegral() == -800);
+        static_assert((a / b).ToIntegral() == -512);
+        static_assert(b < a && a > b && a != b && a == fixedType(2.5));
+
+        EXPECT_DOUBLE_EQ(1.25, (a + b).ToDouble());
+        EXPECT_DOUBLE_EQ(3.75, (a - b).ToDouble());
+        EXPECT_DOUBLE_EQ(-3.125, (a * b).ToDouble());
+        EXPECT_DOUBLE_EQ(-2.0, (a / b).ToDouble());
+        EXPECT_DOUBLE_EQ(1.25, (-b).ToDouble());
+
+        // Products are rounded to the nearest step, quotients truncated.
+        EXPECT_EQ(1, (fixedType::FromRaw(1) * fixedType(0.5)).ToIntegral());
+        EXPECT_EQ(0, (fixedType::FromRaw(1) * fixedType(0.25)).ToIntegral());
+        EXPECT_EQ(85, (fixedType(1.0) / fixedType(3.0)).ToIntegral());
+
+        fixedType value(1.0);
+        value += fixedType(0.5);
+        value *= fixedType(4.0);
+        value -= fixedType(1.0);
+        value /= fixedType(2.0);
+        EXPECT_DOUBLE_EQ(2.5, value.ToDouble());
+
+        // Intermediates are widened, a product larger than the base type still rescales correctly.
+        typedef Shared::FixedPoint<uint16_t, 4, 12> unsignedType;
+        EXPECT_DOUBLE_EQ(15.0, (unsignedType(7.5) * unsignedType(2.0)).ToDouble());
+    }
+
+    TEST(FixedPoint_UnitTests, ValidateOverflow)
+    {
+        typedef Shared::FixedPoint<int16_t, 8, 8>   fixedType;
+        typedef Shared::FixedPoint<uint16_t, 4, 4>  narrowType;
+        typedef Shared::FixedPoint<int32_t, 16, 16> wideType;
+
+        constexpr fixedType big(100.0);
+        EXPECT_EQ(fixedType::MaxRawValue, big.SaturatingAdd(big).ToIntegral());
+        EXPECT_EQ(fixedType::MinRawValue, (-big).SaturatingSub(big).ToIntegral());
+        EXPECT_EQ(fixedType::MaxRawValue, big.SaturatingMul(big).ToIntegral());
+        EXPECT_EQ(fixedType::MinRawValue, big.SaturatingMul(-big).ToIntegral());
+        EXPECT_EQ(fixedType::MaxRawValue, big.SaturatingDiv(fixedType(0.0)).ToIntegral());
+        EXPECT_EQ(fixedType::MinRawValue, (-big).SaturatingDiv(fixedType(0.0)).ToIntegral());
+        EXPECT_DOUBLE_EQ(200.0 - 256.0, big.WrappingAdd(big).ToDouble());
+        EXPECT_DOUBLE_EQ(200.0 - 256.0, (big + big).ToDouble());
+
+        // Types narrower than BASE_TYPE wrap and saturate at INT_BITS + FRAC_BITS.
+        constexpr narrowType ten(10.0);
+        EXPECT_DOUBLE_EQ(4.0, (ten + ten).ToDouble());
+        EXPECT_DOUBLE_EQ(narrowType::GetMax(), ten.SaturatingAdd(ten).ToDouble());
+        EXPECT_DOUBLE_EQ(0.0, narrowType(1.0).SaturatingSub(ten).ToDouble());
+
+        EXPECT_EQ(wideType::MinRawValue, wideType(-30000.0).SaturatingMul(wideType(2.0)).ToIntegral());
+        EXPECT_EQ(wideType::MaxRawValue, wideType(-30000.0).SaturatingMul(wideType(-2.0)).ToIntegral());
+    }
+
+    TEST(FixedPoint_UnitTests, Validate64BitBaseTypes)
+    {
+        typedef Shared::FixedPoint<int64_t, 48, 16> currencyType;
+        typedef Shared::FixedPoint<int64_t, 32, 32> timestampType;
+        typedef Shared::FixedPoint<uint64_t, 0, 64> fractionType;
+
+        static_assert(sizeof(currencyType) == sizeof(int64_t));
+        static_assert(INT64_MAX == timestampType::MaxRawValue);
+        static_assert(UINT64_MAX == fractionType::MaxRawValue);
+
+        // Exact conversions that a double can't represent.
+        constexpr int64_t seconds = (int64_t(1) << 31) - 1;
+        constexpr auto    time    = timestampType::FromInteger(seconds) + timestampType::FromRatio(1, 3);
+        static_assert(time.ToInteger() == seconds);
+        static_assert(time.ToIntegral() == (seconds << 32) + 0x55555555);
+        EXPECT_EQ(-seconds, (-time).ToInteger());
+        EXPECT_EQ((-seconds << 32) - 0x55555555, (-time).ToIntegral());
+
+        auto price = currencyType::FromRatio(1999, 100);
+        EXPECT_EQ(1310065, price.ToIntegral());
+        EXPECT_EQ(59, (price * currencyType::FromInteger(3)).ToInteger());
+        EXPECT_EQ(-6, (price / currencyType::FromInteger(-3)).ToInteger());
+        EXPECT_EQ(-2, currencyType::FromRatio(-5, 2).ToInteger());
+        EXPECT_EQ(-163840, currencyType::FromRatio(5, -2).ToIntegral());
+
+        // 128 bit intermediates keep products and quotients exact.
+        auto big = currencyType::FromInteger(int64_t(1) << 40);
+        EXPECT_EQ(int64_t(1) << 46, (big / currencyType::FromRatio(1, 64)).ToInteger());
+        EXPECT_EQ(int64_t(1) << 34, (big * currencyType::FromRatio(1, 64)).ToInteger());
+        EXPECT_EQ(currencyType::MaxRawValue, big.SaturatingMul(big).ToIntegral());
+        EXPECT_EQ(currencyType::MinRawValue, (-big).SaturatingMul(big).ToIntegral());
+        constexpr auto maxValue = currencyType::FromRaw(currencyType::MaxRawValue);
+        EXPECT_EQ(currencyType::MaxRawValue, maxValue.SaturatingAdd(currencyType::FromRaw(1)).ToIntegral());
+        EXPECT_EQ(currencyType::MinRawValue, maxValue.WrappingAdd(currencyType::FromRaw(2)).ToIntegral());
+
+        auto half    = fractionType::FromRatio(1, 2);
+        auto quarter = fractionType::FromRatio(1, 4);
+        EXPECT_EQ(uint64_t(1) << 63, half.ToIntegral());
+        EXPECT_EQ(quarter, half * half);
+        EXPECT_EQ(half, quarter / half);
+        EXPECT_EQ(fractionType::MaxRawValue, half.SaturatingDiv(quarter).ToIntegral());
+        EXPECT_EQ(0, quarter.SaturatingSub(half).ToIntegral());
+
+        // Doubles at the limits saturate instead of overflowing the conversion.
+        EXPECT_EQ(timestampType::MaxRawValue, timestampType(timestampType::GetMax()).ToIntegral());
+        EXPECT_EQ(timestampType::MinRawValue, timestampType(timestampType::GetMin()).ToIntegral());
+        EXPECT_DOUBLE_EQ(0.75, fractionType(0.75).ToDouble());
+
+        EXPECT_THROW(currencyType::FromInteger(int64_t(1) << 47), std::out_of_range);
+        EXPECT_THROW(currencyType::FromInteger(-(int64_t(1) << 47)), std::out_of_range);
+        EXPECT_THROW(fractionType::FromInteger(1), std::out_of_range);
+        EXPECT_THROW(fractionType::FromRatio(-1, 2), std::out_of_range);
+        EXPECT_THROW(currencyType::FromRatio(INT64_MAX, 2), std::out_of_range);
+        EXPECT_THROW(currencyType::FromRatio(1, 0), std::invalid_argument);
+        EXPECT_EQ(currencyType::MaxRawValue >> 16, currencyType::FromInteger((int64_t(1) << 47) - 1).ToInteger());
+        EXPECT_EQ(0, fractionType::FromInteger(0).ToIntegral());
+    }
 } // namespace Shared
\ No newline at end of file
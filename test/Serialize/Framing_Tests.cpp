@@ -0,0 +1,130 @@
+#include <CRC/CRCTypes.h>
+#include <Serialize/Framing.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace Shared {
+    namespace {
+        std::vector<std::byte> Bytes(std::initializer_list<unsigned char> values)
+        {
+            std::vector<std::byte> bytes;
+            for (unsigned char value : values)
+            {
+                bytes.push_back(std::byte(value));
+            }
+            return bytes;
+        }
+
+        std::vector<std::vector<std::byte>> TestPayloads()
+        {
+            std::vector<std::vector<std::byte>> payloads;
+            payloads.push_back(Bytes({0x11, 0x22, 0x00, 0x33}));
+            payloads.push_back(Bytes({0x00}));
+            payloads.push_back(Bytes({0xC0, 0xDB, 0xDC, 0xDD, 0xC0}));
+            payloads.push_back(Bytes({0x01}));
+
+            // Runs around the 254 byte COBS block limit.
+            for (size_t size : {253, 254, 255, 600})
+            {
+                std::vector<std::byte> payload(size);
+                for (size_t i = 0; i < size; ++i)
+                {
+                    payload[i] = static_cast<std::byte>(i % 255 + 1);
+                }
+                payloads.push_back(payload);
+                payload.back() = std::byte(0);
+                payloads.push_back(payload);
+            }
+            return payloads;
+        }
+    } // namespace
+
+    TEST(Framing_UnitTests, ValidateCobsEncoding)
+    {
+        std::vector<std::byte> encoded;
+        EncodeFrame<CobsFraming>(Bytes({0x11, 0x22, 0x00, 0x33}), encoded);
+        EXPECT_EQ(Bytes({0x03, 0x11, 0x22, 0x02, 0x33, 0x00}), encoded);
+
+        encoded.clear();
+        EncodeFrame<CobsFraming>(Bytes({0x00, 0x00}), encoded);
+        EXPECT_EQ(Bytes({0x01, 0x01, 0x01, 0x00}), encoded);
+    }
+
+    TEST(Framing_UnitTests, ValidateSlipEncoding)
+    {
+        std::vector<std::byte> encoded;
+        EncodeFrame<SlipFraming>(Bytes({0x01, 0xC0, 0x02, 0xDB}), encoded);
+        EXPECT_EQ(Bytes({0x01, 0xDB, 0xDC, 0x02, 0xDB, 0xDD, 0xC0}), encoded);
+    }
+
+    template <class FRAMING, class CRC_HELPER>
+    void ValidateDeframer()
+    {
+        const std::vector<std::vector<std::byte>> payloads = TestPayloads();
+
+        std::vector<std::byte> stream;
+        for (const auto& payload : payloads)
+        {
+            EncodeFrame<FRAMING, CRC_HELPER>(payload, stream);
+        }
+
+        // Feed the stream in chunks of every size, frames end up both inside and across chunks.
+        for (size_t chunkSize : {1, 2, 7, 64, 300, 100000})
+        {
+            std::vector<std::byte>              input = stream;
+            std::vector<std::vector<std::byte>> received;
+            StreamDeframer<FRAMING, CRC_HELPER> deframer(
+                [&](std::span<const std::byte> payload) { received.emplace_back(payload.begin(), payload.end()); });
+
+            for (size_t offset = 0; offset < input.size(); offset += chunkSize)
+            {
+                deframer.Consume(std::span(input).subspan(offset, std::min(chunkSize, input.size() - offset)));
+            }
+            EXPECT_EQ(payloads, received) << chunkSize;
+            EXPECT_EQ(payloads.size(), deframer.GetFrameCount());
+            EXPECT_EQ(0, deframer.GetDroppedFrameCount());
+
+            received.clear();
+            deframer.ConsumeCopy(stream);
+            EXPECT_EQ(payloads, received);
+
+            received.clear();
+            input = stream;
+            deframer.Consume(input);
+            EXPECT_EQ(payloads, received);
+        }
+    }
+
+    TEST(Framing_UnitTests, ValidateDeframer)
+    {
+        ValidateDeframer<CobsFraming, void>();
+        ValidateDeframer<SlipFraming, void>();
+        ValidateDeframer<CobsFraming, XModem16BitCRC>();
+        ValidateDeframer<SlipFraming, DNP16BitCRC>();
+    }
+
+    TEST(Framing_UnitTests, ValidateDroppedFrames)
+    {
+        std::vector<std::vector<std::byte>>         received;
+        StreamDeframer<SlipFraming, XModem16BitCRC> deframer(
+            [&](std::span<const std::byte> payload) { received.emplace_back(payload.begin(), payload.end()); }, 16);
+
+        std::vector<std::byte> stream;
+        EncodeFrame<SlipFraming, XModem16BitCRC>(Bytes({1, 2, 3}), stream);
+        stream[1] ^= std::byte(0x40);
+        EncodeFrame<SlipFraming, XModem16BitCRC>(std::vector<std::byte>(20, std::byte(5)), stream);
+        stream.push_back(std::byte(SlipFraming::Escape));
+        stream.push_back(std::byte(0x42));
+        stream.push_back(std::byte(SlipFraming::Delimiter));
+        EncodeFrame<SlipFraming, XModem16BitCRC>(Bytes({4, 5}), stream);
+
+        deframer.Consume(std::span(stream).first(10));
+        deframer.Consume(std::span(stream).subspan(10));
+
+        EXPECT_EQ(std::vector<std::vector<std::byte>>({Bytes({4, 5})}), received);
+        EXPECT_EQ(3, deframer.GetDroppedFrameCount());
+    }
+} // namespace Shared
@@ -0,0 +1,104 @@
+#include <Serialize/BinaryWriter.hpp>
+#include <Serialize/GatherWriter.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <numeric>
+#include <vector>
+
+namespace Shared {
+    TEST(GatherWriter_UnitTests, ValidateMatchesBinaryWriter)
+    {
+        std::vector<uint32_t> payload(1000);
+        std::iota(payload.begin(), payload.end(), 0);
+        const std::vector<uint16_t> smallArray({1, 2, 3});
+        std::vector<std::byte>      blob(300, std::byte(0x5A));
+
+        GatherWriter<> gatherWriter(256);
+        BinaryWriter<> expected;
+
+        auto writeAll = [&](auto& writer) {
+            writer.WriteNum(uint32_t(0xDEADBEEF));
+            writer.WriteArrayNum(payload.begin(), payload.end(), LengthPrefix::Varint);
+            writer.WriteArrayNum(smallArray.begin(), smallArray.end());
+            writer.WriteVarint(int32_t(-1));
+            writer.WriteBytes(blob);
+            writer.WriteNum(uint8_t(7));
+            writer.WriteBytes(std::span<const std::byte>(blob).first(4));
+        };
+        writeAll(gatherWriter);
+        writeAll(expected);
+
+        ASSERT_EQ(expected.GetSize(), gatherWriter.GetSize());
+        EXPECT_EQ(5, gatherWriter.GetSegmentCount());
+
+        // Large ranges are referenced, not copied.
+        auto segments = gatherWriter.GetSegments();
+        ASSERT_EQ(5, segments.size());
+        EXPECT_EQ(reinterpret_cast<const std::byte*>(payload.data()), segments[1].data());
+        EXPECT_EQ(payload.size() * sizeof(uint32_t), segments[1].size());
+        EXPECT_EQ(blob.data(), segments[3].data());
+
+        std::vector<std::byte> flattened = gatherWriter.Flatten();
+        EXPECT_TRUE(std::equal(
+            flattened.begin(),
+            flattened.end(),
+            expected.GetBegin(),
+            expected.GetEnd(),
+            [](std::byte lhs, unsigned char rhs) { return std::to_integer<unsigned char>(lhs) == rhs; }));
+
+        gatherWriter.Clear();
+        EXPECT_EQ(0, gatherWriter.GetSize());
+        EXPECT_EQ(0, gatherWriter.GetSegmentCount());
+    }
+
+    TEST(GatherWriter_UnitTests, ValidateByteSwappedArraysAreCopied)
+    {
+        std::vector<uint32_t> payload(1000, 0x01020304);
+
+        GatherWriter<true, Endianess::BigEndian> gatherWriter(16);
+        gatherWriter.WriteArrayNum(payload.begin(), payload.end());
+        EXPECT_EQ(1, gatherWriter.GetSegmentCount());
+
+        std::vector<std::byte> flattened = gatherWriter.Flatten();
+        ASSERT_EQ(sizeof(size_t) + payload.size() * sizeof(uint32_t), flattened.size());
+        EXPECT_EQ(std::byte(0x01), flattened[sizeof(size_t)]);
+    }
+
+#if defined(__unix__) || defined(__APPLE__)
+    TEST(GatherWriter_UnitTests, ValidateWriteTo)
+    {
+        std::vector<unsigned char> payload(100000);
+        for (size_t i = 0; i < payload.size(); ++i)
+        {
+            payload[i] = static_cast<unsigned char>(i);
+        }
+
+        GatherWriter<> gatherWriter;
+        for (int i = 0; i < 1500; ++i)
+        {
+            // More segments than IOV_MAX.
+            gatherWriter.WriteNum(int32_t(i));
+            gatherWriter.WriteBytesByReference(std::as_bytes(std::span<const unsigned char>(payload).first(i + 1)));
+        }
+        gatherWriter.WriteArrayNum(payload.begin(), payload.end());
+        ASSERT_GT(gatherWriter.GetSegmentCount(), 3000);
+
+        std::FILE* pFile = std::tmpfile();
+        ASSERT_NE(nullptr, pFile);
+        int fd = fileno(pFile);
+        ASSERT_TRUE(gatherWriter.WriteTo(fd));
+
+        std::vector<std::byte> expected = gatherWriter.Flatten();
+        std::vector<std::byte> written(expected.size() + 1);
+        ASSERT_EQ(0, ::lseek(fd, 0, SEEK_SET));
+        ASSERT_EQ(static_cast<ssize_t>(expected.size()), ::read(fd, written.data(), written.size()));
+        written.pop_back();
+        EXPECT_EQ(expected, written);
+
+        std::fclose(pFile);
+    }
+#endif
+} // namespace Shared
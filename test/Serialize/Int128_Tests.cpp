@@ -0,0 +1,99 @@
+#include <Serialize/Int128.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace Shared {
+    namespace {
+        typedef PortableInt128<true>  portableSigned;
+        typedef PortableInt128<false> portableUnsigned;
+
+        template <class T>
+        portableSigned makeSigned(T high, uint64_t low)
+        {
+            return (portableSigned(high) << 64) + portableSigned(low);
+        }
+
+        std::vector<portableSigned> makeValues()
+        {
+            std::vector<portableSigned> values{0, 1, -1, 2, -2, INT64_MAX, INT64_MIN, UINT64_MAX, makeSigned(1, 0),
+                                               makeSigned(INT64_MAX, UINT64_MAX), makeSigned(INT64_MIN, 0)};
+
+            std::mt19937_64 generator(7);
+            for (int i = 0; i < 50; ++i)
+            {
+                values.push_back(makeSigned(static_cast<int64_t>(generator()) >> (i % 64), generator()));
+                values.push_back(portableSigned(static_cast<int64_t>(generator()) >> (i % 64)));
+            }
+            return values;
+        }
+    } // namespace
+
+    TEST(Int128_UnitTests, PortableArithmetic)
+    {
+        portableSigned big = makeSigned(3, 5);
+        EXPECT_EQ(makeSigned(6, 10), big + big);
+        EXPECT_EQ(makeSigned(-4, UINT64_MAX - 4), -big);
+        EXPECT_EQ(portableSigned(0), big - big);
+        EXPECT_EQ(makeSigned(1, 0), portableSigned(UINT64_MAX) + portableSigned(1));
+
+        // (2^64 - 1)^2 = 2^128 - 2^65 + 1
+        EXPECT_EQ(makeSigned(UINT64_MAX - 1, 1), portableSigned(UINT64_MAX) * portableSigned(UINT64_MAX));
+        EXPECT_EQ(portableSigned(-6), portableSigned(-2) * portableSigned(3));
+
+        EXPECT_EQ(portableSigned(-3), portableSigned(-7) / portableSigned(2));
+        EXPECT_EQ(makeSigned(0, 3), makeSigned(3, 9) / makeSigned(1, 3));
+        EXPECT_EQ(portableUnsigned(UINT64_MAX) << 64, (portableUnsigned(UINT64_MAX) << 64) / portableUnsigned(1));
+
+        EXPECT_EQ(makeSigned(-1, UINT64_MAX - 1), makeSigned(-1, UINT64_MAX - 3) >> 1);
+        EXPECT_EQ(portableSigned(-1), makeSigned(INT64_MIN, 0) >> 127);
+        EXPECT_EQ(portableUnsigned(1), (portableUnsigned(1) << 127) >> 127);
+
+        EXPECT_LT(portableSigned(-1), portableSigned(0));
+        EXPECT_GT(portableUnsigned(-1), portableUnsigned(0));
+        EXPECT_EQ(UINT64_MAX, static_cast<uint64_t>(portableSigned(-1)));
+    }
+
+#if defined(__SIZEOF_INT128__)
+    TEST(Int128_UnitTests, PortableMatchesBuiltin)
+    {
+        auto toBuiltin = [](portableSigned value) {
+            return static_cast<Int128>((static_cast<UInt128>(value.GetHigh()) << 64) | value.GetLow());
+        };
+
+        std::vector<portableSigned> values = makeValues();
+        for (portableSigned lhs : values)
+        {
+            Int128 builtinLhs = toBuiltin(lhs);
+            for (portableSigned rhs : values)
+            {
+                Int128 builtinRhs = toBuiltin(rhs);
+
+                // Wrapping reference results, signed overflow of the built-in type is undefined.
+                UInt128 unsignedLhs = static_cast<UInt128>(builtinLhs);
+                UInt128 unsignedRhs = static_cast<UInt128>(builtinRhs);
+                ASSERT_EQ(static_cast<Int128>(unsignedLhs + unsignedRhs), toBuiltin(lhs + rhs));
+                ASSERT_EQ(static_cast<Int128>(unsignedLhs - unsignedRhs), toBuiltin(lhs - rhs));
+                ASSERT_EQ(static_cast<Int128>(unsignedLhs * unsignedRhs), toBuiltin(lhs * rhs));
+                ASSERT_EQ(builtinLhs < builtinRhs, lhs < rhs);
+                ASSERT_EQ(builtinLhs == builtinRhs, lhs == rhs);
+
+                // INT128_MIN / -1 overflows.
+                if (builtinRhs != 0 && !(builtinRhs == -1 && lhs == makeSigned(INT64_MIN, 0)))
+                {
+                    ASSERT_EQ(builtinLhs / builtinRhs, toBuiltin(lhs / rhs));
+                }
+            }
+
+            for (size_t shift = 0; shift < 128; shift += 7)
+            {
+                ASSERT_EQ(builtinLhs >> shift, toBuiltin(lhs >> shift));
+                ASSERT_EQ(static_cast<Int128>(static_cast<UInt128>(builtinLhs) << shift), toBuiltin(lhs << shift));
+            }
+        }
+    }
+#endif
+} // namespace Shared
@@ -0,0 +1,150 @@
+#include <Serialize/BinaryStream.hpp>
+#include <Serialize/BinaryWriter.hpp>
+#include <Serialize/LZBlock.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace Shared {
+    namespace {
+        std::vector<std::byte> RoundTrip(std::span<const std::byte> src, size_t maxChainLength = 16)
+        {
+            LZBlockCompressor      compressor(maxChainLength);
+            std::vector<std::byte> compressed = compressor.Compress(src);
+            EXPECT_FALSE(compressed.empty());
+            EXPECT_LE(compressed.size(), LZGetMaxCompressedSize(src.size()));
+
+            std::vector<std::byte> decompressed(src.size());
+            EXPECT_EQ(src.size(), LZDecompressBlock(compressed, decompressed));
+            EXPECT_TRUE(std::equal(src.begin(), src.end(), decompressed.begin(), decompressed.end()));
+
+            return compressed;
+        }
+
+        std::vector<std::byte> RandomBytes(size_t size, uint64_t seed)
+        {
+            std::vector<std::byte> bytes(size);
+            for (std::byte& value : bytes)
+            {
+                seed  = seed * 6364136223846793005ull + 1442695040888963407ull;
+                value = static_cast<std::byte>(seed >> 56);
+            }
+            return bytes;
+        }
+    } // namespace
+
+    TEST(LZBlock_UnitTests, ValidateRoundTrip)
+    {
+        RoundTrip({});
+        RoundTrip(RandomBytes(5, 1));
+        RoundTrip(RandomBytes(13, 2));
+        RoundTrip(RandomBytes(100000, 3));
+
+        // Long runs exercise overlapping matches and length extension bytes.
+        std::vector<std::byte> runs(70000, std::byte(0x11));
+        std::fill(runs.begin() + 30000, runs.begin() + 30100, std::byte(0x22));
+        EXPECT_LT(RoundTrip(runs).size(), 1000);
+
+        std::vector<std::byte> pattern;
+        for (size_t i = 0; i < 200000; ++i)
+        {
+            pattern.push_back(static_cast<std::byte>("abcdefg"[i % 7]));
+        }
+        RoundTrip(pattern, 1);
+        RoundTrip(pattern, 64);
+    }
+
+    TEST(LZBlock_UnitTests, ValidateSerializedRecords)
+    {
+        // Records with a counter, a slowly changing value and a constant tag, as typically logged.
+        BinaryWriter<> writer;
+        for (uint32_t i = 0; i < 5000; ++i)
+        {
+            writer.WriteNum(i);
+            writer.WriteNum(1700000000000ull + i * 1000);
+            writer.WriteNum(20.0 + (i / 100) * 0.25);
+            writer.WriteNum(uint16_t(0xBEEF));
+        }
+
+        std::span<const std::byte> bytes(reinterpret_cast<const std::byte*>(&*writer.GetBegin()), writer.GetSize());
+        std::vector<std::byte>     compressed = RoundTrip(bytes);
+        EXPECT_LT(compressed.size() * 2, bytes.size());
+    }
+
+    TEST(LZBlock_UnitTests, ValidateInvalidInput)
+    {
+        std::vector<std::byte> src(1000, std::byte(7));
+        std::vector<std::byte> compressed = LZBlockCompressor().Compress(src);
+
+        std::vector<std::byte> tooSmall(src.size() - 1);
+        EXPECT_THROW(LZDecompressBlock(compressed, tooSmall), std::runtime_error);
+
+        std::vector<std::byte> decompressed(src.size());
+        EXPECT_THROW(LZDecompressBlock(std::span(compressed).first(compressed.size() - 1), decompressed),
+                     std::runtime_error);
+
+        // Offset pointing before the start of the output.
+        const std::vector<std::byte> badOffset({std::byte(0x10), std::byte('a'), std::byte(0x05), std::byte(0x00),
+                                                std::byte(0x00)});
+        EXPECT_THROW(LZDecompressBlock(badOffset, decompressed), std::runtime_error);
+
+        std::vector<std::byte> dest(4);
+        EXPECT_EQ(0, LZBlockCompressor().Compress(src, dest));
+    }
+
+    TEST(LZBlock_UnitTests, ValidateStreamingStage)
+    {
+        std::vector<std::byte> frames;
+        auto                   sink = LZCompressingSink([&](std::span<const std::byte> bytes) {
+            frames.insert(frames.end(), bytes.begin(), bytes.end());
+            return true;
+        });
+
+        std::vector<std::byte> random = RandomBytes(3000, 4);
+        {
+            BinaryStreamWriter<> writer(sink, 4096);
+            for (uint32_t i = 0; i < 20000; ++i)
+            {
+                writer.WriteNum(i % 100);
+                writer.WriteVarint(i);
+            }
+            writer.WriteBytes(random);
+            writer.Flush();
+            EXPECT_LT(frames.size(), writer.GetSize());
+        }
+
+        size_t readLoc{0};
+        auto   source = LZDecompressingSource([&](std::span<std::byte> bytes) -> std::ptrdiff_t {
+            size_t numRead = std::min(bytes.size(), frames.size() - readLoc);
+            std::memcpy(bytes.data(), frames.data() + readLoc, numRead);
+            readLoc += numRead;
+            return static_cast<std::ptrdiff_t>(numRead);
+        });
+
+        BinaryStreamReader<> reader(source, 1000);
+        for (uint32_t i = 0; i < 20000; ++i)
+        {
+            ASSERT_EQ(i % 100, reader.ReadNum<uint32_t>());
+            ASSERT_EQ(i, reader.ReadVarint<uint32_t>());
+        }
+        std::vector<std::byte> readBack(random.size());
+        reader.ReadBytes(readBack);
+        EXPECT_EQ(random, readBack);
+        EXPECT_TRUE(reader.AtEnd());
+
+        // A truncated frame is reported as a source error.
+        frames.resize(frames.size() - 1);
+        readLoc = 0;
+        std::vector<std::byte> buffer(1 << 20);
+        std::ptrdiff_t         result{0};
+        while ((result = source(buffer)) > 0)
+        {
+        }
+        EXPECT_EQ(-1, result);
+    }
+} // namespace Shared
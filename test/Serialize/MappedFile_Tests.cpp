@@ -0,0 +1,78 @@
+#include <Serialize/BinaryWriter.hpp>
+#include <Serialize/MappedFile.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+
+namespace Shared {
+    namespace {
+        std::string WriteTempFile(const unsigned char* pData, size_t size)
+        {
+            char path[] = "/tmp/MappedFile_TestsXXXXXX";
+            int  fd     = ::mkstemp(path);
+            if (fd < 0)
+                return std::string();
+
+            bool ok = size == 0 || ::write(fd, pData, size) == static_cast<ssize_t>(size);
+            ::close(fd);
+
+            return ok ? std::string(path) : std::string();
+        }
+    } // namespace
+
+    TEST(MappedFile_UnitTests, ValidateReader)
+    {
+        const std::vector<double> values({1.5, -2.5, 1e300});
+
+        BinaryWriter<std::vector<unsigned char>::iterator, true, Endianess::BigEndian> writer;
+        writer.WriteNum(uint32_t(0xCAFEBABE));
+        writer.WriteArrayNum(values.begin(), values.end(), LengthPrefix::Varint);
+        writer.WriteVarint(int64_t(-123456789));
+
+        std::string path = WriteTempFile(&*writer.GetBegin(), writer.GetSize());
+        ASSERT_FALSE(path.empty());
+
+        MappedFile mappedFile(path);
+        ::unlink(path.c_str());
+        ASSERT_TRUE(mappedFile.IsOpen());
+        ASSERT_EQ(writer.GetSize(), mappedFile.GetSize());
+        mappedFile.WillNeed(0, mappedFile.GetSize());
+        mappedFile.Advise(AccessPattern::Random);
+
+        auto reader = mappedFile.CreateReader<true, Endianess::BigEndian>();
+        EXPECT_EQ(0xCAFEBABE, reader.ReadNum<uint32_t>());
+        auto view = reader.ReadArrayView<double>(LengthPrefix::Varint);
+        EXPECT_TRUE(std::equal(values.begin(), values.end(), view.begin(), view.end()));
+        EXPECT_EQ(-123456789, reader.ReadVarint<int64_t>());
+        EXPECT_THROW(reader.ReadNum<uint8_t>(), std::runtime_error);
+
+        MappedFile moved(std::move(mappedFile));
+        EXPECT_FALSE(mappedFile.IsOpen());
+        EXPECT_TRUE(moved.IsOpen());
+        EXPECT_EQ(0xCA, moved.GetData()[0]);
+    }
+
+    TEST(MappedFile_UnitTests, ValidateEmptyAndMissingFiles)
+    {
+        std::string path = WriteTempFile(nullptr, 0);
+        ASSERT_FALSE(path.empty());
+
+        MappedFile mappedFile;
+        EXPECT_TRUE(mappedFile.Open(path));
+        ::unlink(path.c_str());
+        EXPECT_EQ(0, mappedFile.GetSize());
+        EXPECT_TRUE(mappedFile.GetBytes().empty());
+        EXPECT_THROW(mappedFile.CreateReader().ReadNum<uint8_t>(), std::runtime_error);
+
+        EXPECT_FALSE(mappedFile.Open(path));
+        EXPECT_FALSE(mappedFile.IsOpen());
+    }
+} // namespace Shared
+#endif
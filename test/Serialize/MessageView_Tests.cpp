@@ -0,0 +1,118 @@
+#include <Serialize/BinaryWriter.hpp>
+#include <Serialize/MessageView.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace Shared {
+    struct ViewTestPosition
+    {
+        int32_t Latitude;
+        int32_t Longitude;
+    };
+
+    template <>
+    struct StructFields<ViewTestPosition> : FieldList<&ViewTestPosition::Latitude, &ViewTestPosition::Longitude> {
+    };
+
+    struct ViewTestReport
+    {
+        uint8_t                 Version;
+        uint64_t                Timestamp;
+        ViewTestPosition        Position;
+        std::array<uint16_t, 4> Readings;
+        double                  Speed;
+    };
+
+    template <>
+    struct StructFields<ViewTestReport>
+        : FieldList<
+              &ViewTestReport::Version,
+              &ViewTestReport::Timestamp,
+              &ViewTestReport::Position,
+              &ViewTestReport::Readings,
+              &ViewTestReport::Speed> {
+    };
+
+    enum class ViewTestFlag
+    {
+        Valid,
+        Moving,
+        Charging
+    };
+
+    struct ViewTestStatus
+    {
+        uint16_t                                    Id;
+        BitSetTemplate<ViewTestFlag, uint8_t, 0x07> Flags{0};
+    };
+
+    template <>
+    struct StructFields<ViewTestStatus> : FieldList<&ViewTestStatus::Id, &ViewTestStatus::Flags> {
+    };
+
+    static_assert(StructFieldOffset<ViewTestReport, &ViewTestReport::Version> == 0);
+    static_assert(StructFieldOffset<ViewTestReport, &ViewTestReport::Timestamp> == 1);
+    static_assert(StructFieldOffset<ViewTestReport, &ViewTestReport::Position> == 9);
+    static_assert(StructFieldOffset<ViewTestReport, &ViewTestReport::Readings> == 17);
+    static_assert(StructFieldOffset<ViewTestReport, &ViewTestReport::Speed> == 25);
+
+    TEST(MessageView_UnitTests, ValidateFieldAccess)
+    {
+        const ViewTestReport report{3, 0x0102030405060708, {-45, 170}, {10, 20, 30, 40}, 12.25};
+
+        BinaryWriter<std::vector<unsigned char>::iterator, true, Endianess::BigEndian> writer;
+        writer.WriteNum(uint16_t(0xFFFF));
+        writer.WriteStruct(report);
+        writer.WriteStruct(report);
+
+        writer.SetLoc(sizeof(uint16_t));
+        auto view = writer.ReadMessageView<ViewTestReport>();
+        EXPECT_EQ(2 + StructWireSize<ViewTestReport>, std::distance(writer.GetBegin(), writer.GetCurLoc()));
+
+        EXPECT_EQ(12.25, view.Get<&ViewTestReport::Speed>());
+        EXPECT_EQ(3, view.Get<&ViewTestReport::Version>());
+        EXPECT_EQ(0x0102030405060708, view.Get<&ViewTestReport::Timestamp>());
+        EXPECT_EQ(-45, view.GetView<&ViewTestReport::Position>().Get<&ViewTestPosition::Latitude>());
+        EXPECT_EQ(170, view.Get<&ViewTestReport::Position>().Longitude);
+        EXPECT_EQ(report.Readings, view.Get<&ViewTestReport::Readings>());
+
+        auto readings = view.GetArrayView<&ViewTestReport::Readings>();
+        ASSERT_EQ(4, readings.size());
+        EXPECT_EQ(30, readings[2]);
+
+        EXPECT_EQ(0x01, std::to_integer<int>(view.GetBytes<&ViewTestReport::Timestamp>()[0]));
+        EXPECT_EQ(StructWireSize<ViewTestReport>, view.GetBytes().size());
+
+        ViewTestReport decoded{};
+        writer.ReadMessageView<ViewTestReport>().Materialize(decoded);
+        EXPECT_EQ(report.Timestamp, decoded.Timestamp);
+        EXPECT_EQ(report.Speed, decoded.Speed);
+        EXPECT_THROW(writer.ReadMessageView<ViewTestReport>(), std::runtime_error);
+    }
+
+    TEST(MessageView_UnitTests, ValidateBitSetField)
+    {
+        ViewTestStatus status{7};
+        status.Flags.SetViaID(ViewTestFlag::Charging, true);
+
+        BinaryWriter<> writer;
+        writer.WriteStruct(status);
+        writer.Reset();
+
+        auto view = writer.ReadMessageView<ViewTestStatus>();
+        EXPECT_EQ(7, view.Get<&ViewTestStatus::Id>());
+        EXPECT_EQ(0x04, view.Get<&ViewTestStatus::Flags>().GetRawValue());
+        EXPECT_TRUE(view.Get<&ViewTestStatus::Flags>().GetViaID(ViewTestFlag::Charging));
+
+        // The raw value is validated when the field is decoded.
+        std::vector<unsigned char> invalid(writer.GetBegin(), writer.GetEnd());
+        invalid[2] = 0x08;
+        BinaryWriter<> corrupt(invalid.begin(), invalid.end());
+        EXPECT_THROW(corrupt.ReadMessageView<ViewTestStatus>().Get<&ViewTestStatus::Flags>(), std::invalid_argument);
+    }
+} // namespace Shared
@@ -5,6 +5,9 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <array>
+#include <deque>
+#include <span>
 #include <variant>
 
 namespace Shared {
@@ -86,6 +89,20 @@ namespace Shared {
 
             EXPECT_EQ(inputs.ExpectedBEResult, std::vector<unsigned char>(pRawData, pRawData + sizeof(T)));
 
+            Shared::SerializeArithmaticType<T, Shared::Endianess::LittleEndian>(std::get<T>(inputs.Value), pRawData);
+            EXPECT_EQ(inputs.ExpectedLEResult, std::vector<unsigned char>(pRawData, pRawData + sizeof(T)));
+
+            std::array<std::byte, sizeof(T)> rawBytes;
+            Shared::SerializeArithmaticType<T, Shared::Endianess::BigEndian>(
+                std::get<T>(inputs.Value),
+                std::span<std::byte, sizeof(T)>(rawBytes));
+            EXPECT_TRUE(std::equal(
+                inputs.ExpectedBEResult.begin(),
+                inputs.ExpectedBEResult.end(),
+                rawBytes.begin(),
+                rawBytes.end(),
+                [](unsigned char lhs, std::byte rhs) { return lhs == static_cast<unsigned char>(rhs); }));
+
             delete[] pRawData;
         }
 
@@ -103,6 +120,19 @@ namespace Shared {
                     inputs.ExpectedBEResult.end());
 
             EXPECT_EQ(std::get<T>(inputs.Value), integralValue);
+
+            integralValue = Shared::DeSerializeArithmaticType<T, Shared::Endianess::LittleEndian>(
+                inputs.ExpectedLEResult.data());
+            EXPECT_EQ(std::get<T>(inputs.Value), integralValue);
+
+            integralValue = Shared::DeSerializeArithmaticType<T, Shared::Endianess::BigEndian>(
+                std::as_bytes(std::span<const unsigned char, sizeof(T)>(inputs.ExpectedBEResult.data(), sizeof(T))));
+            EXPECT_EQ(std::get<T>(inputs.Value), integralValue);
+
+            // Non-contiguous iterators take the byte loop.
+            std::deque<unsigned char> leBytes(inputs.ExpectedLEResult.begin(), inputs.ExpectedLEResult.end());
+            integralValue = Shared::DeSerializeArithmaticType<T>(leBytes.begin(), leBytes.end());
+            EXPECT_EQ(std::get<T>(inputs.Value), integralValue);
         }
     };
 
@@ -259,4 +289,60 @@ namespace Shared {
                  {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF8, 0x3F},
                  {0x3F, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}})));
 
+    template <class T, Endianess endianess>
+    static void TestArrayMatchesScalar(const std::vector<T>& values)
+    {
+        std::vector<unsigned char> scalarResult(values.size() * sizeof(T));
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            auto loc = scalarResult.begin() + i * sizeof(T);
+            Shared::SerializeArithmaticType<T, decltype(loc), endianess>(values[i], loc, loc + sizeof(T));
+        }
+
+        std::vector<unsigned char> bulkResult(values.size() * sizeof(T));
+        Shared::SerializeArithmaticArray<T, unsigned char, endianess>(values.data(), values.size(), bulkResult.data());
+        EXPECT_EQ(scalarResult, bulkResult);
+
+        std::vector<T> readBack(values.size());
+        Shared::DeSerializeArithmaticArray<T, unsigned char, endianess>(
+            bulkResult.data(),
+            readBack.size(),
+            readBack.data());
+        EXPECT_EQ(values, readBack);
+    }
+
+    TEST(SerializeDeserializeArray_UnitTests, ValidateArrayMatchesScalar)
+    {
+        const std::vector<short>              shorts({1000, -1000, 0, 32767, -32768, 7, 8, 9, 10});
+        const std::vector<unsigned int>       uints({222222200, 0, 1, 0xFFFFFFFF, 0x12345678, 5, 6, 7, 8, 9, 10});
+        const std::vector<long long>          longs({22222222153325, -22222222153325, 0, 1, -1});
+        const std::vector<unsigned long long> ulongs({22222222153325, 0xFFFFFFFFFFFFFFFF, 0x0102030405060708});
+        const std::vector<float>              floats({1.5f, -.002f, 0.0f, 1e30f, -1e-30f, 3.0f, 4.0f, 5.0f, 6.0f});
+        const std::vector<double>             doubles({1.5, -.002, 0.0, 1e300, -1e-300});
+        const std::vector<unsigned char>      bytes({0x00, 0x7F, 0x80, 0xFF});
+
+        TestArrayMatchesScalar<short, Endianess::LittleEndian>(shorts);
+        TestArrayMatchesScalar<short, Endianess::BigEndian>(shorts);
+        TestArrayMatchesScalar<unsigned int, Endianess::LittleEndian>(uints);
+        TestArrayMatchesScalar<unsigned int, Endianess::BigEndian>(uints);
+        TestArrayMatchesScalar<long long, Endianess::LittleEndian>(longs);
+        TestArrayMatchesScalar<long long, Endianess::BigEndian>(longs);
+        TestArrayMatchesScalar<unsigned long long, Endianess::LittleEndian>(ulongs);
+        TestArrayMatchesScalar<unsigned long long, Endianess::BigEndian>(ulongs);
+        TestArrayMatchesScalar<float, Endianess::LittleEndian>(floats);
+        TestArrayMatchesScalar<float, Endianess::BigEndian>(floats);
+        TestArrayMatchesScalar<double, Endianess::LittleEndian>(doubles);
+        TestArrayMatchesScalar<double, Endianess::BigEndian>(doubles);
+        TestArrayMatchesScalar<unsigned char, Endianess::BigEndian>(bytes);
+    }
+
+    TEST(SerializeDeserializeArray_UnitTests, ValidateByteSwap)
+    {
+        static_assert(ByteSwap<uint16_t>(0x0102) == 0x0201);
+        static_assert(ByteSwap<uint32_t>(0x01020304) == 0x04030201);
+        static_assert(ByteSwap<uint64_t>(0x0102030405060708) == 0x0807060504030201);
+
+        volatile uint32_t value{0xAABBCCDD};
+        EXPECT_EQ(0xDDCCBBAA, ByteSwap<uint32_t>(value));
+    }
 } // namespace Shared
\ No newline at end of file
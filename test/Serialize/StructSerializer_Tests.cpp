@@ -0,0 +1,225 @@
+#include <Serialize/BinaryWriter.hpp>
+#include <Serialize/StructSerializer.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <stdexcept>
+#include <vector>
+
+namespace Shared {
+    struct StructTestHeader
+    {
+        uint16_t Id;
+        uint8_t  Flags;
+        uint8_t  Kind;
+        uint32_t Length;
+    };
+
+    template <>
+    struct StructFields<StructTestHeader>
+        : FieldList<
+              &StructTestHeader::Id,
+              &StructTestHeader::Flags,
+              &StructTestHeader::Kind,
+              &StructTestHeader::Length> {
+    };
+
+    // Members listed out of declaration order, so the wire layout no longer matches memory.
+    struct StructTestReordered
+    {
+        uint16_t Id;
+        uint8_t  Flags;
+        uint8_t  Kind;
+        uint32_t Length;
+    };
+
+    template <>
+    struct StructFields<StructTestReordered>
+        : FieldList<
+              &StructTestReordered::Length,
+              &StructTestReordered::Id,
+              &StructTestReordered::Flags,
+              &StructTestReordered::Kind> {
+    };
+
+    enum class StructTestMode : uint8_t
+    {
+        Off,
+        On,
+        Auto
+    };
+
+    struct StructTestPadded
+    {
+        StructTestMode         Mode;
+        bool                   Enabled;
+        float                  Gain;
+        std::array<int16_t, 3> Samples;
+        StructTestHeader       Header;
+    };
+
+    template <>
+    struct StructFields<StructTestPadded>
+        : FieldList<
+              &StructTestPadded::Mode,
+              &StructTestPadded::Enabled,
+              &StructTestPadded::Gain,
+              &StructTestPadded::Samples,
+              &StructTestPadded::Header> {
+    };
+
+    enum class StructTestState
+    {
+        Idle,
+        Running,
+        Stopped
+    };
+
+    class StructTestStateEnum
+        : public Enum<StructTestState, StructTestState::Idle, StructTestState::Stopped, uint8_t, StructTestStateEnum> {
+      public:
+        StructTestStateEnum()
+            : Enum()
+        {
+        }
+        StructTestStateEnum(StructTestState value)
+            : Enum(value)
+        {
+        }
+    };
+
+    enum class StructTestBits
+    {
+        Bit0,
+        Bit1,
+        Bit2,
+        Bit3
+    };
+
+    struct StructTestStatus
+    {
+        StructTestStateEnum                           State;
+        FixedPoint<int16_t, 8, 8>                     Temperature;
+        BitSetTemplate<StructTestBits, uint8_t, 0x0F> Bits{0};
+        std::array<StructTestHeader, 2>               Headers;
+    };
+
+    template <>
+    struct StructFields<StructTestStatus>
+        : FieldList<
+              &StructTestStatus::State,
+              &StructTestStatus::Temperature,
+              &StructTestStatus::Bits,
+              &StructTestStatus::Headers> {
+    };
+
+    static_assert(StructWireSize<StructTestHeader> == 8);
+    static_assert(WireFormat<StructTestHeader>::RawLayout);
+    static_assert(!WireFormat<StructTestReordered>::RawLayout);
+    static_assert(StructWireSize<StructTestPadded> == 1 + 1 + 4 + 6 + 8);
+    static_assert(!WireFormat<StructTestPadded>::RawLayout);
+    static_assert(StructWireSize<StructTestStatus> == 1 + 2 + 1 + 16);
+
+    TEST(StructSerializer_UnitTests, ValidateRawLayout)
+    {
+        const StructTestHeader header{0x0102, 0x03, 0x04, 0x05060708};
+
+        std::array<unsigned char, 8> littleEndian;
+        SerializeStruct(header, littleEndian.data());
+        EXPECT_EQ((std::array<unsigned char, 8>{0x02, 0x01, 0x03, 0x04, 0x08, 0x07, 0x06, 0x05}), littleEndian);
+
+        std::array<unsigned char, 8> bigEndian;
+        SerializeStruct<StructTestHeader, Endianess::BigEndian>(header, bigEndian.data());
+        EXPECT_EQ((std::array<unsigned char, 8>{0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08}), bigEndian);
+
+        StructTestHeader decoded{};
+        DeSerializeStruct<StructTestHeader, Endianess::BigEndian>(bigEndian.data(), decoded);
+        EXPECT_EQ(header.Id, decoded.Id);
+        EXPECT_EQ(header.Flags, decoded.Flags);
+        EXPECT_EQ(header.Kind, decoded.Kind);
+        EXPECT_EQ(header.Length, decoded.Length);
+
+        const StructTestReordered reordered{header.Id, header.Flags, header.Kind, header.Length};
+
+        std::array<unsigned char, 8> reorderedBytes;
+        SerializeStruct(reordered, reorderedBytes.data());
+        EXPECT_EQ((std::array<unsigned char, 8>{0x08, 0x07, 0x06, 0x05, 0x02, 0x01, 0x03, 0x04}), reorderedBytes);
+    }
+
+    TEST(StructSerializer_UnitTests, ValidateNestedFields)
+    {
+        StructTestPadded value{};
+        value.Mode    = StructTestMode::Auto;
+        value.Enabled = true;
+        value.Gain    = 1.5f;
+        value.Samples = {-1, 2, -3};
+        value.Header  = {7, 8, 9, 10};
+
+        BinaryWriter<> writer;
+        writer.WriteStruct(value);
+        ASSERT_EQ(StructWireSize<StructTestPadded>, writer.GetSize());
+        EXPECT_EQ(0x02, writer.GetBegin()[0]);
+        EXPECT_EQ(0x01, writer.GetBegin()[1]);
+
+        writer.Reset();
+        StructTestPadded decoded = writer.ReadStruct<StructTestPadded>();
+        EXPECT_EQ(value.Mode, decoded.Mode);
+        EXPECT_EQ(value.Enabled, decoded.Enabled);
+        EXPECT_EQ(value.Gain, decoded.Gain);
+        EXPECT_EQ(value.Samples, decoded.Samples);
+        EXPECT_EQ(value.Header.Id, decoded.Header.Id);
+        EXPECT_EQ(value.Header.Length, decoded.Header.Length);
+        EXPECT_THROW(writer.ReadStruct<StructTestPadded>(), std::runtime_error);
+
+        // Non-contiguous buffers are staged through a fixed size array and produce the same bytes.
+        std::deque<unsigned char>                        dequeBuffer(StructWireSize<StructTestPadded>);
+        BinaryWriter<std::deque<unsigned char>::iterator> dequeWriter(dequeBuffer.begin(), dequeBuffer.end());
+        dequeWriter.WriteStruct(value);
+        EXPECT_TRUE(std::equal(writer.GetBegin(), writer.GetEnd(), dequeBuffer.begin(), dequeBuffer.end()));
+
+        dequeWriter.Reset();
+        EXPECT_EQ(value.Samples, dequeWriter.ReadStruct<StructTestPadded>().Samples);
+    }
+
+    TEST(StructSerializer_UnitTests, ValidateSharedTypes)
+    {
+        StructTestStatus status;
+        status.State       = StructTestState::Running;
+        status.Temperature = FixedPoint<int16_t, 8, 8>(21.5);
+        status.Bits.SetViaID(StructTestBits::Bit2, true);
+        status.Headers[0] = {1, 2, 3, 4};
+        status.Headers[1] = {5, 6, 7, 8};
+
+        BinaryWriter<std::vector<unsigned char>::iterator, true, Endianess::BigEndian> writer;
+        writer.WriteStruct(status);
+        ASSERT_EQ(StructWireSize<StructTestStatus>, writer.GetSize());
+
+        const std::vector<unsigned char> expectedPrefix({0x01, 0x15, 0x80, 0x04, 0x00, 0x01});
+        EXPECT_TRUE(std::equal(expectedPrefix.begin(), expectedPrefix.end(), writer.GetBegin()));
+
+        writer.Reset();
+        StructTestStatus decoded;
+        writer.ReadStruct(decoded);
+        EXPECT_EQ(status.State, decoded.State);
+        EXPECT_DOUBLE_EQ(21.5, decoded.Temperature.ToDouble());
+        EXPECT_EQ(0x04, decoded.Bits.GetRawValue());
+        EXPECT_EQ(5, decoded.Headers[1].Id);
+        EXPECT_EQ(8, decoded.Headers[1].Length);
+
+        // Enum and BitSetTemplate values are validated when read.
+        std::vector<unsigned char> invalidState(writer.GetBegin(), writer.GetEnd());
+        invalidState[0] = 0x07;
+        EXPECT_THROW(
+            (DeSerializeStruct<StructTestStatus, Endianess::BigEndian>(invalidState.data(), decoded)),
+            std::invalid_argument);
+
+        std::vector<unsigned char> invalidBits(writer.GetBegin(), writer.GetEnd());
+        invalidBits[3] = 0x10;
+        EXPECT_THROW(
+            (DeSerializeStruct<StructTestStatus, Endianess::BigEndian>(invalidBits.data(), decoded)),
+            std::invalid_argument);
+    }
+} // namespace Shared
@@ -0,0 +1,98 @@
+#include <Serialize/TimeSeriesCodec.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace Shared {
+    namespace {
+        void ExpectRoundTrip(const std::vector<int64_t>& timestamps, const std::vector<double>& values)
+        {
+            TimeSeriesEncoder encoder;
+            encoder.Append(timestamps, values);
+            auto bytes = encoder.Flush();
+
+            std::vector<int64_t> decodedTimestamps(timestamps.size());
+            std::vector<double>  decodedValues(values.size());
+            TimeSeriesDecoder<>::DecodeBlock(bytes, encoder.GetCount(), decodedTimestamps.data(), decodedValues.data());
+
+            EXPECT_EQ(timestamps, decodedTimestamps);
+            for (size_t i = 0; i < values.size(); ++i)
+            {
+                // Compare bit patterns so NaN payloads and signed zeros are checked too.
+                EXPECT_EQ(0, std::memcmp(&values[i], &decodedValues[i], sizeof(double))) << i;
+            }
+        }
+    } // namespace
+
+    TEST(TimeSeriesCodec_UnitTests, ValidateRegularSeries)
+    {
+        std::vector<int64_t> timestamps;
+        std::vector<double>  values;
+        for (int64_t i = 0; i < 10000; ++i)
+        {
+            timestamps.push_back(1700000000000 + i * 1000 + (i % 97 == 0 ? 3 : 0));
+            values.push_back(20.0 + static_cast<double>((i / 50) % 8) * 0.5);
+        }
+
+        TimeSeriesEncoder encoder;
+        encoder.Append(timestamps, values);
+        size_t encodedSize = encoder.Flush().size();
+        EXPECT_LT(encodedSize * 10, timestamps.size() * 16);
+
+        ExpectRoundTrip(timestamps, values);
+    }
+
+    TEST(TimeSeriesCodec_UnitTests, ValidateIrregularSeries)
+    {
+        std::vector<int64_t> timestamps({std::numeric_limits<int64_t>::max(), std::numeric_limits<int64_t>::min(), 0,
+                                         5, 100, 400, 3000, -1000000000000, 7});
+        std::vector<double>  values({1.0, -0.0, std::numeric_limits<double>::quiet_NaN(),
+                                     std::numeric_limits<double>::infinity(), 1e-300, 3.141592653589793, 3.25,
+                                     std::numeric_limits<double>::denorm_min(), -1e300});
+
+        ExpectRoundTrip(timestamps, values);
+
+        std::vector<int64_t> randomTimestamps;
+        std::vector<double>  randomValues;
+        uint64_t             state = 12345;
+        for (size_t i = 0; i < 2000; ++i)
+        {
+            state = state * 6364136223846793005ull + 1442695040888963407ull;
+            randomTimestamps.push_back(static_cast<int64_t>(i * 10 + (state >> 60)));
+            randomValues.push_back(std::sin(static_cast<double>(i) * 0.01) * static_cast<double>(state >> 40));
+        }
+        ExpectRoundTrip(randomTimestamps, randomValues);
+    }
+
+    TEST(TimeSeriesCodec_UnitTests, ValidateStreamingDecode)
+    {
+        TimeSeriesEncoder encoder;
+        encoder.Append(10, 1.5);
+        encoder.Append(20, 1.5);
+        encoder.Append(35, 2.5);
+        auto bytes = encoder.Flush();
+
+        TimeSeriesDecoder<> decoder(bytes, encoder.GetCount());
+        int64_t             timestamp;
+        double              value;
+        ASSERT_TRUE(decoder.Next(timestamp, value));
+        EXPECT_EQ(10, timestamp);
+        EXPECT_EQ(1.5, value);
+        ASSERT_TRUE(decoder.Next(timestamp, value));
+        EXPECT_EQ(20, timestamp);
+        ASSERT_TRUE(decoder.Next(timestamp, value));
+        EXPECT_EQ(35, timestamp);
+        EXPECT_EQ(2.5, value);
+        EXPECT_FALSE(decoder.Next(timestamp, value));
+
+        // Claiming more samples than were encoded runs past the end of the data.
+        TimeSeriesDecoder<> truncated(bytes.first(4), 3);
+        EXPECT_THROW(truncated.Next(timestamp, value), std::runtime_error);
+    }
+} // namespace Shared
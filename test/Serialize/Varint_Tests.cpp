@@ -0,0 +1,114 @@
+#include <Serialize/Varint.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace Shared {
+    TEST(Varint_UnitTests, ValidateZigZag)
+    {
+        EXPECT_EQ(0, ZigZagEncode<int32_t>(0));
+        EXPECT_EQ(1, ZigZagEncode<int32_t>(-1));
+        EXPECT_EQ(2, ZigZagEncode<int32_t>(1));
+        EXPECT_EQ(3, ZigZagEncode<int32_t>(-2));
+        EXPECT_EQ(0xFFFFFFFE, ZigZagEncode<int32_t>(std::numeric_limits<int32_t>::max()));
+        EXPECT_EQ(0xFFFFFFFF, ZigZagEncode<int32_t>(std::numeric_limits<int32_t>::min()));
+
+        for (int64_t value : {int64_t(0), int64_t(-1), int64_t(63), int64_t(-64), std::numeric_limits<int64_t>::min()})
+        {
+            EXPECT_EQ(value, ZigZagDecode(ZigZagEncode(value)));
+        }
+    }
+
+    TEST(Varint_UnitTests, ValidateEncode)
+    {
+        unsigned char encoded[MaxVarintSize<uint64_t>];
+
+        ASSERT_EQ(1, EncodeVarint(0, encoded));
+        EXPECT_EQ(0x00, encoded[0]);
+
+        ASSERT_EQ(1, EncodeVarint(127, encoded));
+        EXPECT_EQ(0x7F, encoded[0]);
+
+        ASSERT_EQ(2, EncodeVarint(300, encoded));
+        EXPECT_EQ(0xAC, encoded[0]);
+        EXPECT_EQ(0x02, encoded[1]);
+
+        ASSERT_EQ(10, EncodeVarint(std::numeric_limits<uint64_t>::max(), encoded));
+        EXPECT_EQ(0x01, encoded[9]);
+
+        EXPECT_EQ(1, VarintSize(0));
+        EXPECT_EQ(1, VarintSize(127));
+        EXPECT_EQ(2, VarintSize(128));
+        EXPECT_EQ(9, VarintSize(std::numeric_limits<uint64_t>::max() >> 1));
+        EXPECT_EQ(10, VarintSize(std::numeric_limits<uint64_t>::max()));
+    }
+
+    TEST(Varint_UnitTests, ValidateDecode)
+    {
+        // Exercise every encoded length, with and without enough trailing bytes for the word decoder.
+        for (int shift = 0; shift < 64; ++shift)
+        {
+            for (uint64_t value : {uint64_t(1) << shift, (uint64_t(1) << shift) - 1, ~uint64_t(0) >> shift})
+            {
+                std::vector<unsigned char> encoded(MaxVarintSize<uint64_t> + 8, 0xFF);
+                size_t                     numBytes = EncodeVarint(value, encoded.data());
+
+                uint64_t decoded{0};
+                ASSERT_EQ(numBytes, DecodeVarint(encoded.data(), encoded.data() + encoded.size(), decoded));
+                EXPECT_EQ(value, decoded);
+
+                decoded = 0;
+                ASSERT_EQ(numBytes, DecodeVarint(encoded.data(), encoded.data() + numBytes, decoded));
+                EXPECT_EQ(value, decoded);
+
+                EXPECT_EQ(0, DecodeVarint(encoded.data(), encoded.data() + numBytes - 1, decoded));
+            }
+        }
+
+        std::vector<unsigned char> overlong(11, 0x80);
+        uint64_t                   decoded{0};
+        EXPECT_EQ(0, DecodeVarint(overlong.data(), overlong.data() + overlong.size(), decoded));
+
+        std::vector<unsigned char> overflow({0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x02});
+        EXPECT_EQ(0, DecodeVarint(overflow.data(), overflow.data() + overflow.size(), decoded));
+    }
+
+    TEST(Varint_UnitTests, ValidateDecodeArray)
+    {
+        std::vector<int32_t> values;
+        for (int i = 0; i < 100; ++i)
+        {
+            values.push_back(i % 7 == 0 ? i * 100000 : -i);
+        }
+        for (int i = 0; i < 40; ++i)
+        {
+            values.push_back(i - 20);
+        }
+        values.push_back(std::numeric_limits<int32_t>::min());
+
+        std::vector<unsigned char> encoded(values.size() * MaxVarintSize<int32_t>);
+        size_t                     numBytes{0};
+        for (int32_t value : values)
+        {
+            numBytes += EncodeVarint(ToVarintValue(value), encoded.data() + numBytes);
+        }
+
+        std::vector<int32_t> decoded(values.size());
+        const unsigned char* pLast =
+            DecodeVarintArray(encoded.data(), encoded.data() + numBytes, decoded.data(), decoded.size());
+        EXPECT_EQ(encoded.data() + numBytes, pLast);
+        EXPECT_EQ(values, decoded);
+
+        EXPECT_EQ(
+            nullptr,
+            DecodeVarintArray(encoded.data(), encoded.data() + numBytes - 1, decoded.data(), decoded.size()));
+
+        // Values that do not fit the destination type are rejected.
+        std::vector<unsigned char> tooBig({0x80, 0x02});
+        uint8_t                    byteValue;
+        EXPECT_EQ(nullptr, DecodeVarintArray(tooBig.data(), tooBig.data() + tooBig.size(), &byteValue, 1));
+    }
+} // namespace Shared